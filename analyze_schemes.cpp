@@ -15,7 +15,7 @@
 #include "src/entities/buffer_writer.h"
 #include "src/schemes/fractional_scheme.h"
 
-std::vector<std::string> getSchemePaths(const std::string &inputPath, bool shuffle, std::mt19937 &generator) {
+std::vector<std::string> getSchemePaths(const std::string &inputPath, bool shuffle, RandomGenerator &generator) {
     std::vector<std::string> paths;
     std::vector<std::string> extensions = {"ZT.txt", "Z.txt", "Q.txt"};
 
@@ -102,7 +102,7 @@ int runAnalyzeSchemes(const ArgParser &parser) {
     std::cout << "- type invariant: " << (saveTypeInvariant || saveAll ? "yes" : "no") << std::endl;
     std::cout << "- buds invariant: " << (saveBudsInvariant || saveAll ? "yes" : "no") << std::endl;
 
-    std::mt19937 generator(seed);
+    RandomGenerator generator(seed, "mt19937");
     std::vector<std::string> paths = getSchemePaths(inputPath, shuffle, generator);
     if (paths.empty()) {
         std::cout << "There are no scheme files" << std::endl;
@@ -0,0 +1,470 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+#include <filesystem>
+
+#include "src/utils.h"
+#include "src/entities/arg_parser.h"
+#include "src/entities/operation_counters.h"
+#include "src/parameters/flip_parameters.h"
+#include "src/schemes/ternary_scheme.hpp"
+#include "src/schemes/mod3_scheme.hpp"
+#include "src/schemes/binary_scheme.hpp"
+
+struct BenchmarkResult {
+    std::string name;
+    std::string ring;
+    std::string type;
+    std::string dimension;
+    std::string source;
+    int rank;
+    int finalRank;
+    bool valid;
+    OperationCounters counters;
+    double walkTime;
+    double copyTime;
+    double validationTime;
+
+    void writeJSON(std::ostream &os) const {
+        os << "{";
+        os << "\"name\": \"" << name << "\", ";
+        os << "\"ring\": \"" << ring << "\", ";
+        os << "\"type\": \"" << type << "\", ";
+        os << "\"dimension\": \"" << dimension << "\", ";
+        os << "\"source\": \"" << source << "\", ";
+        os << "\"rank\": " << rank << ", ";
+        os << "\"final_rank\": " << finalRank << ", ";
+        os << "\"valid\": " << (valid ? "true" : "false") << ", ";
+        os << "\"operations\": ";
+        counters.writeJSON(os);
+        os << ", ";
+        os << "\"walk_time\": " << walkTime << ", ";
+        os << "\"flips_per_second\": " << counters.flips / walkTime << ", ";
+        os << "\"operations_per_second\": " << counters.getOperations() / walkTime << ", ";
+        os << "\"plus_per_second\": " << counters.plus / walkTime << ", ";
+        os << "\"splits_per_second\": " << counters.splits / walkTime << ", ";
+        os << "\"reductions_per_second\": " << (counters.reductions + counters.flipReductions) / walkTime << ", ";
+        os << "\"copy_ns\": " << copyTime * 1e9 << ", ";
+        os << "\"validation_ms\": " << validationTime * 1e3;
+        os << "}";
+    }
+};
+
+struct BenchmarkMetric {
+    std::string key;
+    bool higherIsBetter;
+};
+
+const std::vector<BenchmarkMetric> COMPARED_METRICS = {
+    {"flips_per_second", true},
+    {"operations_per_second", true},
+    {"copy_ns", false},
+    {"validation_ms", false}
+};
+
+const std::vector<std::vector<int>> NAIVE_DIMENSIONS = {
+    {3, 3, 3},
+    {4, 4, 4},
+    {5, 5, 5},
+    {6, 6, 6},
+    {9, 9, 9},
+    {12, 12, 12}
+};
+
+double getElapsed(std::chrono::high_resolution_clock::time_point startTime) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
+
+template <typename Scheme>
+void randomWalk(Scheme &scheme, const FlipParameters &flipParameters, RandomGenerator &generator) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_int_distribution<size_t> plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations);
+
+    size_t flipsCount = 0;
+    size_t plusIterations = plusDistribution(generator);
+    int bestRank = scheme.getRank();
+
+    for (size_t iteration = 0; iteration < flipParameters.flipIterations; iteration++) {
+        int prevRank = scheme.getRank();
+
+        if (!scheme.tryFlip(generator)) {
+            if (scheme.tryExpand(generator))
+                flipsCount = 0;
+
+            continue;
+        }
+
+        if (flipParameters.reduceProbability && uniform(generator) < flipParameters.reduceProbability && scheme.tryReduce())
+            flipsCount = 0;
+
+        if (flipParameters.sandwichingProbability && uniform(generator) < flipParameters.sandwichingProbability)
+            scheme.trySandwiching(generator);
+
+        int rank = scheme.getRank();
+        if (rank < prevRank)
+            flipsCount = 0;
+
+        flipsCount++;
+        bestRank = std::min(bestRank, rank);
+
+        if (flipsCount >= plusIterations && rank < bestRank + flipParameters.plusDiff && scheme.tryExpand(generator)) {
+            flipsCount = 0;
+            plusIterations = plusDistribution(generator);
+        }
+    }
+}
+
+template <typename Scheme>
+BenchmarkResult runBenchmark(const Scheme &initial, const std::string &type, const std::string &source, const FlipParameters &flipParameters, int seed, int repeats, int copies) {
+    BenchmarkResult result;
+    result.ring = initial.getRing();
+    result.type = type;
+    result.dimension = initial.getDimension();
+    result.source = source;
+    result.name = result.ring + "/" + type + "/" + result.dimension + "/" + source;
+    result.rank = initial.getRank();
+    result.walkTime = 0;
+    result.copyTime = 0;
+    result.validationTime = 0;
+
+    for (int repeat = 0; repeat < repeats; repeat++) {
+        Scheme scheme(initial);
+        RandomGenerator generator(seed, "xoshiro");
+
+        auto walkStart = std::chrono::high_resolution_clock::now();
+        randomWalk(scheme, flipParameters, generator);
+        double walkTime = getElapsed(walkStart);
+
+        Scheme target(initial);
+        auto copyStart = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < copies; i++)
+            target.copy(i % 2 ? initial : scheme);
+        double copyTime = getElapsed(copyStart) / copies;
+
+        auto validationStart = std::chrono::high_resolution_clock::now();
+        bool valid = scheme.validate();
+        double validationTime = getElapsed(validationStart);
+
+        if (repeat == 0 || walkTime < result.walkTime)
+            result.walkTime = walkTime;
+
+        if (repeat == 0 || copyTime < result.copyTime)
+            result.copyTime = copyTime;
+
+        if (repeat == 0 || validationTime < result.validationTime)
+            result.validationTime = validationTime;
+
+        result.counters = scheme.getCounters();
+        result.finalRank = scheme.getRank();
+        result.valid = valid;
+    }
+
+    std::cout << "| " << std::left << std::setw(40) << result.name << " | " << std::right;
+    std::cout << std::setw(4) << result.rank << " | ";
+    std::cout << std::setw(4) << result.finalRank << " | ";
+    std::cout << std::setw(9) << prettyInt(size_t(result.counters.flips / result.walkTime)) << " | ";
+    std::cout << std::setw(9) << prettyInt(size_t(result.counters.getOperations() / result.walkTime)) << " | ";
+    std::cout << std::setw(9) << std::fixed << std::setprecision(1) << result.copyTime * 1e9 << " | ";
+    std::cout << std::setw(10) << std::fixed << std::setprecision(3) << result.validationTime * 1e3 << " |";
+    std::cout << (result.valid ? "" : " invalid") << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    return result;
+}
+
+template <template<typename> typename Scheme, typename T>
+void benchmarkNaive(int n1, int n2, int n3, const std::string &type, const FlipParameters &flipParameters, int seed, int repeats, int copies, std::vector<BenchmarkResult> &results) {
+    Scheme<T> scheme;
+    if (!scheme.initializeNaive(n1, n2, n3))
+        return;
+
+    results.push_back(runBenchmark(scheme, type, "naive", flipParameters, seed, repeats, copies));
+}
+
+template <template<typename> typename Scheme, typename T>
+void benchmarkStored(const std::string &path, const std::string &type, const FlipParameters &flipParameters, int seed, int repeats, int copies, std::vector<BenchmarkResult> &results) {
+    Scheme<T> scheme;
+    if (!scheme.read(path, true)) {
+        std::cout << "Skip \"" << path << "\": unable to read scheme" << std::endl;
+        return;
+    }
+
+    results.push_back(runBenchmark(scheme, type, std::filesystem::path(path).filename().string(), flipParameters, seed, repeats, copies));
+}
+
+template <template<typename> typename Scheme>
+void benchmarkSizes(int maxMatrixElements, int n1, int n2, int n3, const std::string &path, const FlipParameters &flipParameters, int seed, int repeats, int copies, std::vector<BenchmarkResult> &results) {
+    if (maxMatrixElements <= 16) {
+        if (path.empty())
+            benchmarkNaive<Scheme, uint16_t>(n1, n2, n3, "uint16", flipParameters, seed, repeats, copies, results);
+        else
+            benchmarkStored<Scheme, uint16_t>(path, "uint16", flipParameters, seed, repeats, copies, results);
+    }
+    else if (maxMatrixElements <= 32) {
+        if (path.empty())
+            benchmarkNaive<Scheme, uint32_t>(n1, n2, n3, "uint32", flipParameters, seed, repeats, copies, results);
+        else
+            benchmarkStored<Scheme, uint32_t>(path, "uint32", flipParameters, seed, repeats, copies, results);
+    }
+    else if (maxMatrixElements <= 64) {
+        if (path.empty())
+            benchmarkNaive<Scheme, uint64_t>(n1, n2, n3, "uint64", flipParameters, seed, repeats, copies, results);
+        else
+            benchmarkStored<Scheme, uint64_t>(path, "uint64", flipParameters, seed, repeats, copies, results);
+    }
+    else if (maxMatrixElements <= 128) {
+        if (path.empty())
+            benchmarkNaive<Scheme, __uint128_t>(n1, n2, n3, "uint128", flipParameters, seed, repeats, copies, results);
+        else
+            benchmarkStored<Scheme, __uint128_t>(path, "uint128", flipParameters, seed, repeats, copies, results);
+    }
+    else if (maxMatrixElements <= 256) {
+        if (path.empty())
+            benchmarkNaive<Scheme, uint256_t>(n1, n2, n3, "uint256", flipParameters, seed, repeats, copies, results);
+        else
+            benchmarkStored<Scheme, uint256_t>(path, "uint256", flipParameters, seed, repeats, copies, results);
+    }
+    else {
+        std::cout << "Skip " << (path.empty() ? getDimension(n1, n2, n3) : "\"" + path + "\"") << ": matrix elements exceed uint256_t" << std::endl;
+    }
+}
+
+void benchmarkRing(const std::string &ring, int maxMatrixElements, int n1, int n2, int n3, const std::string &path, const FlipParameters &flipParameters, int seed, int repeats, int copies, std::vector<BenchmarkResult> &results) {
+    if (ring == "Z2")
+        benchmarkSizes<BinaryScheme>(maxMatrixElements, n1, n2, n3, path, flipParameters, seed, repeats, copies, results);
+    else if (ring == "Z3")
+        benchmarkSizes<Mod3Scheme>(maxMatrixElements, n1, n2, n3, path, flipParameters, seed, repeats, copies, results);
+    else
+        benchmarkSizes<TernaryScheme>(maxMatrixElements, n1, n2, n3, path, flipParameters, seed, repeats, copies, results);
+}
+
+bool saveResults(const std::string &path, const std::vector<BenchmarkResult> &results, const FlipParameters &flipParameters, int seed, int repeats) {
+    std::ofstream f(path);
+    if (!f) {
+        std::cout << "Unable to open file \"" << path << "\" for writing results" << std::endl;
+        return false;
+    }
+
+    f << "{" << std::endl;
+    f << "  \"backend\": \"" << getBitVectorBackend() << "\"," << std::endl;
+    f << "  \"compiler\": \"" << __VERSION__ << "\"," << std::endl;
+    f << "  \"seed\": " << seed << "," << std::endl;
+    f << "  \"repeats\": " << repeats << "," << std::endl;
+    f << "  \"random_walk_parameters\": ";
+    flipParameters.writeJSON(f);
+    f << "," << std::endl;
+    f << "  \"results\": [" << std::endl;
+
+    for (size_t i = 0; i < results.size(); i++) {
+        f << "    ";
+        results[i].writeJSON(f);
+        f << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    f << "  ]" << std::endl;
+    f << "}" << std::endl;
+    f.close();
+
+    std::cout << "Results were saved to \"" << path << "\"" << std::endl;
+    return true;
+}
+
+bool readValue(const std::string &line, const std::string &key, std::string &value) {
+    std::string pattern = "\"" + key + "\": ";
+    size_t begin = line.find(pattern);
+    if (begin == std::string::npos)
+        return false;
+
+    begin += pattern.size();
+
+    if (line[begin] == '"') {
+        size_t end = line.find('"', begin + 1);
+        value = line.substr(begin + 1, end - begin - 1);
+    }
+    else {
+        size_t end = line.find_first_of(",}", begin);
+        value = line.substr(begin, end - begin);
+    }
+
+    return true;
+}
+
+bool readResults(const std::string &path, std::unordered_map<std::string, std::string> &lines, std::vector<std::string> &names) {
+    std::ifstream f(path);
+    if (!f) {
+        std::cout << "Unable to open benchmark results \"" << path << "\"" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::string name;
+
+    while (std::getline(f, line)) {
+        if (!readValue(line, "name", name))
+            continue;
+
+        lines[name] = line;
+        names.push_back(name);
+    }
+
+    f.close();
+    return true;
+}
+
+bool compareResults(const std::string &baselinePath, const std::string &currentPath, double threshold) {
+    std::unordered_map<std::string, std::string> baselineLines;
+    std::unordered_map<std::string, std::string> currentLines;
+    std::vector<std::string> baselineNames;
+    std::vector<std::string> currentNames;
+
+    if (!readResults(baselinePath, baselineLines, baselineNames) || !readResults(currentPath, currentLines, currentNames))
+        return false;
+
+    std::cout << std::endl << "Compare \"" << currentPath << "\" with baseline \"" << baselinePath << "\" (threshold: " << threshold * 100 << "%)" << std::endl;
+
+    int regressions = 0;
+    int changed = 0;
+
+    for (const std::string &name : currentNames) {
+        auto it = baselineLines.find(name);
+        if (it == baselineLines.end()) {
+            std::cout << "- " << name << ": no baseline" << std::endl;
+            continue;
+        }
+
+        std::string baselineFlips, currentFlips;
+        readValue(it->second, "flips", baselineFlips);
+        readValue(currentLines[name], "flips", currentFlips);
+
+        if (baselineFlips != currentFlips) {
+            std::cout << "- " << name << ": walk changed, flips " << baselineFlips << " -> " << currentFlips << std::endl;
+            changed++;
+        }
+
+        for (const BenchmarkMetric &metric : COMPARED_METRICS) {
+            std::string baselineValue, currentValue;
+            if (!readValue(it->second, metric.key, baselineValue) || !readValue(currentLines[name], metric.key, currentValue))
+                continue;
+
+            double baseline = std::stod(baselineValue);
+            double current = std::stod(currentValue);
+            if (baseline <= 0)
+                continue;
+
+            double change = (current - baseline) / baseline;
+            bool regression = metric.higherIsBetter ? change < -threshold : change > threshold;
+
+            if (!regression)
+                continue;
+
+            std::cout << "- " << name << ": " << metric.key << " regressed " << baselineValue << " -> " << currentValue << " (" << std::showpos << std::setprecision(3) << change * 100 << std::noshowpos << "%)" << std::endl;
+            regressions++;
+        }
+    }
+
+    for (const std::string &name : baselineNames)
+        if (currentLines.find(name) == currentLines.end())
+            std::cout << "- " << name << ": missing in current results" << std::endl;
+
+    if (regressions == 0 && changed == 0)
+        std::cout << "No regressions found" << std::endl;
+    else
+        std::cout << regressions << " regressions, " << changed << " changed walks" << std::endl;
+
+    return regressions == 0;
+}
+
+int main(int argc, char **argv) {
+    ArgParser parser("benchmark", "Measure flip graph throughput on fixed-seed random walks");
+
+    parser.add("--input-path", "-i", ArgType::Path, "Path to stored scheme, directory with schemes or paths.txt file to benchmark in addition to naive schemes");
+    parser.add("--output-path", "-o", ArgType::Path, "Path to save benchmark results", "bench.json");
+    parser.addChoices("--ring", "-r", ArgType::String, "Coefficient ring to benchmark", {"all", "ZT", "Z2", "Z3"}, "all");
+    parser.add("--no-naive", ArgType::Flag, "Skip benchmarks on naive schemes");
+    parser.add("--seed", ArgType::UInt, "Random seed of the walks", "42");
+    parser.add("--repeats", ArgType::Natural, "Number of repeats of each benchmark, the fastest one is reported", "3");
+    parser.add("--copies", ArgType::Natural, "Number of scheme copies for measuring copy cost", "10K");
+
+    parser.addSection("Comparison");
+    parser.add("--baseline-path", "-b", ArgType::Path, "Path to baseline results to compare with");
+    parser.add("--compare-path", "-c", ArgType::Path, "Path to results to compare with baseline instead of running benchmarks");
+    parser.add("--threshold", ArgType::Real, "Relative change treated as a regression", "0.05");
+
+    FlipParameters::addToParser(parser, "Random walk parameters");
+
+    if (!parser.parse(argc, argv))
+        return -1;
+
+    double threshold = std::stod(parser["--threshold"]);
+
+    if (parser.isSet("--compare-path")) {
+        if (!parser.isSet("--baseline-path")) {
+            std::cerr << "--compare-path requires --baseline-path" << std::endl;
+            return -1;
+        }
+
+        return compareResults(parser["--baseline-path"], parser["--compare-path"], threshold) ? 0 : 1;
+    }
+
+    FlipParameters flipParameters;
+    flipParameters.parse(parser);
+
+    int seed = std::stoi(parser["--seed"]);
+    int repeats = std::stoi(parser["--repeats"]);
+    int copies = parseNatural(parser["--copies"]);
+    std::string outputPath = parser["--output-path"];
+
+    std::vector<std::string> rings = {"ZT", "Z2", "Z3"};
+    if (parser["--ring"] != "all")
+        rings = {parser["--ring"]};
+
+    std::vector<std::string> paths;
+    if (parser.isSet("--input-path"))
+        paths = getSchemePathsFromPath(parser["--input-path"], {".txt"}, false);
+
+    std::cout << "Benchmark parameters:" << std::endl;
+    std::cout << "- backend: " << getBitVectorBackend() << std::endl;
+    std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- repeats: " << repeats << std::endl;
+    std::cout << "- copies: " << prettyInt(copies) << std::endl;
+    std::cout << "- stored schemes: " << paths.size() << std::endl;
+    std::cout << std::endl;
+    std::cout << flipParameters << std::endl;
+
+    std::cout << "+------------------------------------------+------+------+-----------+-----------+-----------+------------+" << std::endl;
+    std::cout << "| benchmark                                | rank | curr |  flips/s  |   ops/s   |  copy ns  | validate ms|" << std::endl;
+    std::cout << "+------------------------------------------+------+------+-----------+-----------+-----------+------------+" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+
+    for (const std::string &ring : rings) {
+        if (!parser.isSet("--no-naive")) {
+            for (const std::vector<int> &dimension : NAIVE_DIMENSIONS) {
+                int n1 = dimension[0], n2 = dimension[1], n3 = dimension[2];
+                benchmarkRing(ring, std::max(n1 * n2, std::max(n2 * n3, n3 * n1)), n1, n2, n3, "", flipParameters, seed, repeats, copies, results);
+            }
+        }
+
+        for (const std::string &path : paths) {
+            int maxMatrixElements = getMaxMatrixElements(path, false);
+            if (maxMatrixElements > 0)
+                benchmarkRing(ring, maxMatrixElements, 0, 0, 0, path, flipParameters, seed, repeats, copies, results);
+        }
+    }
+
+    std::cout << "+------------------------------------------+------+------+-----------+-----------+-----------+------------+" << std::endl;
+
+    if (!saveResults(outputPath, results, flipParameters, seed, repeats))
+        return -1;
+
+    if (parser.isSet("--baseline-path"))
+        return compareResults(parser["--baseline-path"], outputPath, threshold) ? 0 : 1;
+
+    return 0;
+}
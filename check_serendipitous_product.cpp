@@ -15,7 +15,7 @@
 #include "src/entities/buffer_writer.h"
 #include "src/schemes/fractional_scheme.h"
 
-std::vector<std::string> getSchemePaths(const std::string &inputPath, bool shuffle, std::mt19937 &generator, const std::string &ring) {
+std::vector<std::string> getSchemePaths(const std::string &inputPath, bool shuffle, RandomGenerator &generator, const std::string &ring) {
     std::vector<std::string> paths;
     std::unordered_map<std::string, std::vector<std::string>> ring2extensions = {
         {"ZT", {"ZT.txt"}},
@@ -62,7 +62,7 @@ std::unordered_map<std::string, int> getKnownRanks(const std::string &ring, int
     return knownRanks;
 }
 
-bool checkSerendipitousProduct(const FractionalScheme &scheme, std::mt19937 &generator, std::unordered_map<std::string, int> &knownRanks, int iterations, bool showEqualBest) {
+bool checkSerendipitousProduct(const FractionalScheme &scheme, RandomGenerator &generator, std::unordered_map<std::string, int> &knownRanks, int iterations, bool showEqualBest) {
     FlipStructureOptimizer optimizer = scheme.getFullStructureOptimizer();
     bool found = false;
 
@@ -94,6 +94,7 @@ int runCheckSerendipitousProduct(const ArgParser &parser) {
     bool showEqualBest = parser.isSet("--show-equal-best");
 
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     if (seed == 0)
         seed = time(0);
 
@@ -105,7 +106,7 @@ int runCheckSerendipitousProduct(const ArgParser &parser) {
     if (!makeDirectory(outputPath))
         return -1;
 
-    std::vector<std::mt19937> generators = initRandomGenerators(seed, threads);
+    std::vector<RandomGenerator> generators = initRandomGenerators(seed, threads, generatorType);
     std::vector<BufferWriter> writers;
 
     for (int i = 0; i < threads; i++)
@@ -120,6 +121,7 @@ int runCheckSerendipitousProduct(const ArgParser &parser) {
     std::cout << "- threads: " << threads << std::endl;
     std::cout << "- iterations: " << iterations << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- show equal best: " << (showEqualBest ? "yes" : "no") << std::endl;
     std::cout << std::endl;
 
@@ -169,6 +171,7 @@ int main(int argc, char *argv[]) {
 
     parser.addSection("Other parameters");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
     parser.add("--iterations", ArgType::Natural, "Iterations of random checking", "25");
     parser.add("--show-equal-best", ArgType::Flag, "Show only schemes with equal ranks to best known in {Q, Z, ZT} rings");
 
@@ -4,12 +4,12 @@
 #include <string>
 #include <random>
 #include <ctime>
-#include <unordered_set>
 #include <omp.h>
 
 #include "src/utils.h"
 #include "src/entities/arg_parser.h"
 #include "src/entities/sha1.h"
+#include "src/entities/fingerprint_set.h"
 #include "src/schemes/binary_scheme.hpp"
 #include "src/schemes/mod3_scheme.hpp"
 #include "src/schemes/ternary_scheme.hpp"
@@ -26,14 +26,6 @@ std::string getSavePath(const Scheme &scheme, const std::string &outputPath, int
     return ss.str();
 }
 
-template <typename Scheme>
-std::string getHash(const Scheme &scheme, const std::string &unique) {
-    if (unique == "structure")
-        return scheme.getStructureHash();
-
-    return scheme.getHash();
-}
-
 template <template<typename> typename Scheme, typename T>
 int runFindAlternativeSchemes(const ArgParser &parser) {
     std::string inputPath = parser["--input-path"];
@@ -48,6 +40,7 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
 
     size_t maxCount = parseNatural(parser["--max-count"]);
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     std::string format = parser["--format"];
     int maxMatrixElements = sizeof(T) * 8;
 
@@ -67,6 +60,7 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
     std::cout << std::endl;
     std::cout << "- max count: " << maxCount << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- format: " << format << std::endl;
     std::cout << "- max matrix elements: " << maxMatrixElements << " (uint" << maxMatrixElements << "_t)" << std::endl;
     std::cout << std::endl << std::endl;
@@ -91,11 +85,11 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
     std::cout << std::endl;
     std::cout << std::endl;
 
-    std::vector<std::mt19937> generators = initRandomGenerators(seed, threads);
+    std::vector<RandomGenerator> generators = initRandomGenerators(seed, threads, generatorType);
     std::uniform_real_distribution<double> uniform(0.0, 1.0);
 
-    std::unordered_set<std::string> hashes;
-    hashes.insert(getHash(initialScheme, unique));
+    FingerprintSet fingerprints;
+    fingerprints.insert(getUniqueFingerprint(initialScheme, unique));
 
     std::vector<Scheme<T>> schemes(threads);
     for (int i = 0; i < threads; i++)
@@ -108,12 +102,12 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
     std::cout << "+-----------+-------------+------------+-----------------+" << std::endl;
 
     for (size_t iteration = 1; count < maxCount; iteration++) {
-        std::vector<std::string> hashesThreads(threads, "");
+        std::vector<SchemeFingerprint> fingerprintsThreads(threads);
 
         #pragma omp parallel for num_threads(threads)
         for (int i = 0; i < threads; i++) {
             Scheme<T>& scheme = schemes[i];
-            std::mt19937& generator = generators[i];
+            RandomGenerator& generator = generators[i];
 
             if (!scheme.tryFlip(generator) || (scheme.getRank() < targetRank + plusDiff && uniform(generator) < plusProbability))
                 scheme.tryExpand(generator);
@@ -124,12 +118,11 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
             if (scheme.getRank() != targetRank)
                 continue;
 
-            hashesThreads[i] = getHash(scheme, unique);
+            fingerprintsThreads[i] = getUniqueFingerprint(scheme, unique);
         }
 
         for (int i = 0; i < threads; i++) {
-            std::string hash = hashesThreads[i];
-            if (hash.empty() || hashes.find(hash) != hashes.end())
+            if (fingerprintsThreads[i].empty() || !fingerprints.insert(fingerprintsThreads[i]))
                 continue;
 
             count++;
@@ -145,8 +138,6 @@ int runFindAlternativeSchemes(const ArgParser &parser) {
                 schemes[i].saveJson(path + ".json");
             else
                 schemes[i].saveTxt(path + ".txt");
-
-            hashes.insert(hash);
         }
     }
 
@@ -172,7 +163,13 @@ int runFindAlternativeSchemesSizes(const ArgParser &parser) {
     if (maxMatrixElements <= 128)
         return runFindAlternativeSchemes<Scheme, __uint128_t>(parser);
 
-    return runFindAlternativeSchemes<Scheme, uint256_t>(parser);
+    if (maxMatrixElements <= 256)
+        return runFindAlternativeSchemes<Scheme, uint256_t>(parser);
+
+    if (maxMatrixElements <= 512)
+        return runFindAlternativeSchemes<Scheme, uint512_t>(parser);
+
+    return runFindAlternativeSchemes<Scheme, uint1024_t>(parser);
 }
 
 int main(int argc, char **argv) {
@@ -196,6 +193,7 @@ int main(int argc, char **argv) {
     parser.addSection("Other parameters");
     parser.add("--target-rank", ArgType::Natural, "Rank of alternative schemes");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
 
     if (!parser.parse(argc, argv))
         return 0;
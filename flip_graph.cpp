@@ -11,6 +11,7 @@
 #include "src/parameters/flip_parameters.h"
 #include "src/parameters/pool_parameters.h"
 #include "src/parameters/metrics_parameters.h"
+#include "src/parameters/checkpoint_parameters.h"
 #include "src/schemes/ternary_scheme.hpp"
 #include "src/schemes/mod3_scheme.hpp"
 #include "src/schemes/binary_scheme.hpp"
@@ -21,6 +22,17 @@ int getMaxMatrixElements(const ArgParser &parser) {
     if (parser.isSet("--input-path"))
         return getMaxMatrixElements(parser["--input-path"], parser.isSet("--multiple"));
 
+    if (parser.isSet("--resume-checkpoint")) {
+        CheckpointHeader header;
+        if (!header.read(parser["--resume-checkpoint"]))
+            return -1;
+
+        int n1 = header.dimension[0];
+        int n2 = header.dimension[1];
+        int n3 = header.dimension[2];
+        return std::max(n1 * n2, std::max(n2 * n3, n3 * n1));
+    }
+
     int n1 = std::stoi(parser["-n1"]);
     int n2 = std::stoi(parser["-n2"]);
     int n3 = std::stoi(parser["-n3"]);
@@ -28,20 +40,11 @@ int getMaxMatrixElements(const ArgParser &parser) {
 }
 
 template <typename FlipGraph>
-int runFlipGraph(FlipGraph &flipGraph, const ArgParser &parser, int targetRank) {
-    bool valid;
-    if (parser.isSet("--input-path")) {
-        valid = flipGraph.initializeFromFile(parser["--input-path"], parser.isSet("--multiple"), !parser.isSet("--no-verify"));
-    }
-    else {
-        valid = flipGraph.initializeNaive(std::stoi(parser["-n1"]), std::stoi(parser["-n2"]), std::stoi(parser["-n3"]));
-    }
-
-    if (!valid)
-        return -1;
+bool initializeFlipGraph(FlipGraph &flipGraph, const ArgParser &parser) {
+    if (parser.isSet("--input-path"))
+        return flipGraph.initializeFromFile(parser["--input-path"], parser.isSet("--multiple"), !parser.isSet("--no-verify"));
 
-    flipGraph.run(targetRank);
-    return 0;
+    return flipGraph.initializeNaive(std::stoi(parser["-n1"]), std::stoi(parser["-n2"]), std::stoi(parser["-n3"]));
 }
 
 template <template<typename> typename Scheme, typename T>
@@ -62,11 +65,17 @@ int runFlipGraph(const ArgParser &parser) {
     MetricsParameters metricsParameters;
     metricsParameters.parse(parser);
 
+    CheckpointParameters checkpointParameters;
+    checkpointParameters.parse(parser);
+
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     int topCount = std::stoi(parser["--top-count"]);
     int targetRank = std::stoi(parser["--target-rank"]);
     double copyBestProbability = std::stod(parser["--copy-best-probability"]);
     int maxImprovements = std::stoi(parser["--max-improvements"]);
+    bool async = parser.isSet("--async");
+    bool numa = parser.isSet("--numa");
     int maxMatrixElements = sizeof(T) * 8;
 
     if (seed == 0)
@@ -80,6 +89,8 @@ int runFlipGraph(const ArgParser &parser) {
 
     if (parser.isSet("--input-path"))
         std::cout << "- input path: " << parser["--input-path"] << std::endl;
+    else if (parser.isSet("--resume-checkpoint"))
+        std::cout << "- resume checkpoint: " << parser["--resume-checkpoint"] << std::endl;
     else
         std::cout << "- dimension: " << parser["-n1"] << "x" << parser["-n2"] << "x" << parser["-n3"] << std::endl;
 
@@ -93,14 +104,20 @@ int runFlipGraph(const ArgParser &parser) {
     if (metricsParameters.use)
         std::cout << metricsParameters << std::endl;
 
+    if (checkpointParameters.use)
+        std::cout << checkpointParameters << std::endl;
+
     std::cout << "Other parameters:" << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- top count: " << topCount << std::endl;
     if (targetRank > 0)
         std::cout << "- target rank: " << targetRank << std::endl;
     if (!poolParameters.use) {
         std::cout << "- copy best probability: " << copyBestProbability << std::endl;
         std::cout << "- max improvements: " << maxImprovements << std::endl;
+        std::cout << "- async: " << (async ? "yes" : "no") << std::endl;
+        std::cout << "- numa: " << (numa ? "yes" : "no") << std::endl;
     }
     std::cout << "- max matrix elements: " << maxMatrixElements << " (uint" << maxMatrixElements << "_t)" << std::endl;
     std::cout << std::endl;
@@ -108,13 +125,32 @@ int runFlipGraph(const ArgParser &parser) {
     if (!makeDirectory(outputPath))
         return -1;
 
+    if (checkpointParameters.use && std::filesystem::path(checkpointParameters.path).has_parent_path() && !makeDirectory(std::filesystem::path(checkpointParameters.path).parent_path().string()))
+        return -1;
+
     if (poolParameters.use) {
-        FlipGraphPool<Scheme<T>> flipGraphPool(count, outputPath, threads, flipParameters, poolParameters, metricsParameters, seed, topCount, format);
-        return runFlipGraph(flipGraphPool, parser, targetRank);
+        FlipGraphPool<Scheme<T>> flipGraphPool(count, outputPath, threads, flipParameters, poolParameters, metricsParameters, seed, generatorType, topCount, format);
+        if (!initializeFlipGraph(flipGraphPool, parser))
+            return -1;
+
+        flipGraphPool.run(targetRank);
+        return 0;
+    }
+
+    FlipGraph<Scheme<T>> flipGraph(count, outputPath, threads, numa, flipParameters, metricsParameters, checkpointParameters, copyBestProbability, seed, generatorType, topCount, maxImprovements, format);
+    if (parser.isSet("--resume-checkpoint")) {
+        if (!flipGraph.initializeFromCheckpoint(parser["--resume-checkpoint"]))
+            return -1;
     }
+    else if (!initializeFlipGraph(flipGraph, parser))
+        return -1;
 
-    FlipGraph<Scheme<T>> flipGraph(count, outputPath, threads, flipParameters, metricsParameters, copyBestProbability, seed, topCount, maxImprovements, format);
-    return runFlipGraph(flipGraph, parser, targetRank);
+    if (async)
+        flipGraph.runAsync(targetRank);
+    else
+        flipGraph.run(targetRank);
+
+    return 0;
 }
 
 template <template<typename> typename Scheme>
@@ -135,12 +171,27 @@ int runFlipGraphSizes(const ArgParser &parser) {
     if (maxMatrixElements <= 128)
         return runFlipGraph<Scheme, __uint128_t>(parser);
 
-    return runFlipGraph<Scheme, uint256_t>(parser);
+    if (maxMatrixElements <= 256)
+        return runFlipGraph<Scheme, uint256_t>(parser);
+
+    if (maxMatrixElements <= 512)
+        return runFlipGraph<Scheme, uint512_t>(parser);
+
+    return runFlipGraph<Scheme, uint1024_t>(parser);
 }
 
 bool checkInputArguments(const ArgParser &parser) {
+    if (parser.isSet("--resume-checkpoint")) {
+        if (parser.isSet("--input-path") || parser.isSet("-n1") || parser.isSet("-n2") || parser.isSet("-n3") || parser.isSet("--multiple")) {
+            std::cerr << "--resume-checkpoint can not be used with dimension args (-n1 -n2 -n3) or an input file (-i)" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
     if (!parser.isSet("--input-path") && (!parser.isSet("-n1") || !parser.isSet("-n2") || !parser.isSet("-n3"))) {
-        std::cerr << "Must provide either dimension args (-n1 -n2 -n3) or an input file (-i)" << std::endl;
+        std::cerr << "Must provide either dimension args (-n1 -n2 -n3), an input file (-i) or a checkpoint (--resume-checkpoint)" << std::endl;
         return false;
     }
 
@@ -158,6 +209,16 @@ bool checkInputArguments(const ArgParser &parser) {
 }
 
 bool checkPoolArguments(const ArgParser &parser) {
+    if (parser.isSet("--use-pool") && parser.isSet("--async")) {
+        std::cerr << "--async can not be used with --use-pool" << std::endl;
+        return false;
+    }
+
+    if (parser.isSet("--numa") && (parser.isSet("--use-pool") || parser.isSet("--async"))) {
+        std::cerr << "--numa can not be used with --use-pool or --async" << std::endl;
+        return false;
+    }
+
     if (parser.isSet("--use-pool"))
         return true;
 
@@ -193,6 +254,20 @@ bool checkMetricsArguments(const ArgParser &parser) {
     return true;
 }
 
+bool checkCheckpointArguments(const ArgParser &parser) {
+    if (parser.isSet("--use-pool") && (parser.isSet("--save-checkpoints") || parser.isSet("--resume-checkpoint"))) {
+        std::cerr << "--save-checkpoints and --resume-checkpoint can not be used with --use-pool" << std::endl;
+        return false;
+    }
+
+    if (!parser.isSet("--save-checkpoints") && (parser.isSet("--checkpoint-path") || parser.isSet("--checkpoint-interval"))) {
+        std::cerr << "--checkpoint-path and --checkpoint-interval can only be used with --save-checkpoints" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 int main(int argc, char **argv) {
     ArgParser parser("flip_graph", "Find fast matrix multiplication schemes using flip graph");
 
@@ -215,18 +290,22 @@ int main(int argc, char **argv) {
     FlipParameters::addToParser(parser, "Random walk parameters");
     PoolParameters::addToParser(parser, "Pool parameters");
     MetricsParameters::addToParser(parser, "Metrics parameters");
+    CheckpointParameters::addToParser(parser, "Checkpoint parameters");
 
     parser.addSection("Other parameters");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
     parser.add("--top-count", ArgType::Natural, "Number of top schemes to report", "10");
     parser.add("--target-rank", ArgType::Natural, "Stop search when this rank is found, 0 searches for minimum", "0");
     parser.add("--copy-best-probability", ArgType::Real, "Probability to replace scheme with best scheme after improvement, from 0.0 to 1.0", "0.5");
     parser.add("--max-improvements", ArgType::Natural, "Maximum saved recent improvements for reset sampling", "10");
+    parser.add("--async", ArgType::Flag, "Run runners asynchronously, reporting without waiting for slow runners (not reproducible)");
+    parser.add("--numa", ArgType::Flag, "Pin threads to CPUs, split runners between NUMA nodes and allocate their schemes on these nodes");
 
     if (!parser.parse(argc, argv))
         return 0;
 
-    if (!checkInputArguments(parser) || !checkPoolArguments(parser) || !checkMetricsArguments(parser))
+    if (!checkInputArguments(parser) || !checkPoolArguments(parser) || !checkMetricsArguments(parser) || !checkCheckpointArguments(parser))
         return -1;
 
     if (parser["--ring"] == "Z2")
@@ -160,7 +160,13 @@ int runLiftSchemesSizes(const ArgParser &parser) {
     if (maxMatrixElements <= 128)
         return runLiftSchemes<Scheme, __uint128_t>(parser);
 
-    return runLiftSchemes<Scheme, uint256_t>(parser);
+    if (maxMatrixElements <= 256)
+        return runLiftSchemes<Scheme, uint256_t>(parser);
+
+    if (maxMatrixElements <= 512)
+        return runLiftSchemes<Scheme, uint512_t>(parser);
+
+    return runLiftSchemes<Scheme, uint1024_t>(parser);
 }
 
 int main(int argc, char *argv[]) {
@@ -180,7 +186,7 @@ int main(int argc, char *argv[]) {
     parser.add("--fix-fractions", ArgType::Flag, "Try to rescale fractions to integers");
 
     parser.addSection("Other parameters");
-    parser.addChoices("--int-width", ArgType::String, "Integer bit width (16/32/64/128/256), determines maximum matrix elements", {"16", "32", "64", "128", "256", "auto"}, "auto");
+    parser.addChoices("--int-width", ArgType::String, "Integer bit width (16/32/64/128/256/512/1024), determines maximum matrix elements", {"16", "32", "64", "128", "256", "512", "1024", "auto"}, "auto");
 
     if (!parser.parse(argc, argv))
         return 0;
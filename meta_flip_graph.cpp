@@ -11,6 +11,7 @@
 #include "src/parameters/flip_parameters.h"
 #include "src/parameters/meta_pool_parameters.h"
 #include "src/parameters/meta_parameters.h"
+#include "src/parameters/metrics_parameters.h"
 #include "src/schemes/ternary_scheme.hpp"
 #include "src/schemes/mod3_scheme.hpp"
 #include "src/schemes/binary_scheme.hpp"
@@ -56,7 +57,11 @@ int runMetaFlipGraph(const ArgParser &parser) {
     MetaParameters metaParameters;
     metaParameters.parse(parser);
 
+    MetricsParameters metricsParameters;
+    metricsParameters.parse(parser);
+
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     int topCount = std::stoi(parser["--top-count"]);
     std::string improveRing = parser["--improve-ring"];
     int maxMatrixElements = sizeof(T) * 8;
@@ -81,8 +86,12 @@ int runMetaFlipGraph(const ArgParser &parser) {
     std::cout << poolParameters << std::endl;
     std::cout << metaParameters << std::endl;
 
+    if (metricsParameters.use)
+        std::cout << metricsParameters << std::endl;
+
     std::cout << "Other parameters:" << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- top count: " << topCount << std::endl;
     if (improveRing != "")
         std::cout << "- improve ring: " << improveRing << std::endl;
@@ -93,11 +102,11 @@ int runMetaFlipGraph(const ArgParser &parser) {
         return -1;
 
     if (poolParameters.use) {
-        MetaFlipGraphPool<Scheme<T>> metaFlipGraphPool(count, outputPath, threads, flipParameters, poolParameters, metaParameters, seed, format);
+        MetaFlipGraphPool<Scheme<T>> metaFlipGraphPool(count, outputPath, threads, flipParameters, poolParameters, metaParameters, metricsParameters, seed, generatorType, format);
         return runMetaFlipGraph(metaFlipGraphPool, parser);
     }
 
-    MetaFlipGraph<Scheme<T>> metaFlipGraph(count, outputPath, threads, flipParameters, metaParameters, seed, topCount, format);
+    MetaFlipGraph<Scheme<T>> metaFlipGraph(count, outputPath, threads, flipParameters, metaParameters, seed, generatorType, topCount, format);
     return runMetaFlipGraph(metaFlipGraph, parser);
 }
 
@@ -125,7 +134,13 @@ int runMetaFlipGraphSizes(const ArgParser &parser) {
     if (maxMatrixElements <= 128)
         return runMetaFlipGraph<Scheme, __uint128_t>(parser);
 
-    return runMetaFlipGraph<Scheme, uint256_t>(parser);
+    if (maxMatrixElements <= 256)
+        return runMetaFlipGraph<Scheme, uint256_t>(parser);
+
+    if (maxMatrixElements <= 512)
+        return runMetaFlipGraph<Scheme, uint512_t>(parser);
+
+    return runMetaFlipGraph<Scheme, uint1024_t>(parser);
 }
 
 bool checkInputArguments(const ArgParser &parser) {
@@ -152,6 +167,20 @@ bool checkInputArguments(const ArgParser &parser) {
     return true;
 }
 
+bool checkMetricsArguments(const ArgParser &parser) {
+    if (!parser.isSet("--save-metrics") && parser.isSet("--metrics-path")) {
+        std::cerr << "--metrics-path can only be used with --save-metrics" << std::endl;
+        return false;
+    }
+
+    if (parser.isSet("--save-metrics") && !parser.isSet("--use-pool")) {
+        std::cerr << "--save-metrics can only be used with --use-pool" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 int main(int argc, char **argv) {
     ArgParser parser("meta_flip_graph", "Find fast matrix multiplication schemes using meta flip graph");
 
@@ -174,17 +203,19 @@ int main(int argc, char **argv) {
     FlipParameters::addToParser(parser, "Random walk parameters");
     MetaPoolParameters::addToParser(parser, "Pool parameters");
     MetaParameters::addToParser(parser, "Meta operations parameters");
+    MetricsParameters::addToParser(parser, "Metrics parameters");
 
     parser.addSection("Other parameters");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
     parser.add("--top-count", ArgType::Natural, "Number of top schemes to report", "10");
     parser.addChoices("--improve-ring", ArgType::String, "Only save schemes that improve known rank for this ring (saves all by default)", {"ZT", "Z", "Q"}, "");
-    parser.addChoices("--int-width", ArgType::String, "Integer bit width (16/32/64/128/256), determines maximum matrix elements", {"16", "32", "64", "128", "256"}, "64");
+    parser.addChoices("--int-width", ArgType::String, "Integer bit width (16/32/64/128/256/512/1024), determines maximum matrix elements", {"16", "32", "64", "128", "256", "512", "1024"}, "64");
 
     if (!parser.parse(argc, argv))
         return 0;
 
-    if (!checkInputArguments(parser))
+    if (!checkInputArguments(parser) || !checkMetricsArguments(parser))
         return -1;
 
     if (parser["--ring"] == "Z2")
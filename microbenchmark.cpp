@@ -0,0 +1,392 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "src/utils.h"
+#include "src/entities/arg_parser.h"
+#include "src/entities/bit_vector.hpp"
+#include "src/entities/ternary_vector.hpp"
+#include "src/entities/mod3_vector.hpp"
+#include "src/entities/flip_set.h"
+
+const int POOL_SIZE = 256;
+
+template <typename T>
+inline void keep(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline double getNanoseconds() {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+inline uint64_t getCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Sample {
+    double nanoseconds;
+    double cycles;
+};
+
+class MicroBenchmark {
+    std::string filter;
+    int warmup;
+    int samples;
+    size_t operations;
+    double outlierThreshold;
+public:
+    MicroBenchmark(const std::string &filter, int warmup, int samples, size_t operations, double outlierThreshold);
+
+    template <typename Operation>
+    void run(const std::string &name, const std::string &type, Operation operation);
+
+    static void printHeader();
+    static void printFooter();
+private:
+    static double median(std::vector<double> values);
+};
+
+MicroBenchmark::MicroBenchmark(const std::string &filter, int warmup, int samples, size_t operations, double outlierThreshold) {
+    this->filter = filter;
+    this->warmup = warmup;
+    this->samples = samples;
+    this->operations = operations;
+    this->outlierThreshold = outlierThreshold;
+}
+
+template <typename Operation>
+void MicroBenchmark::run(const std::string &name, const std::string &type, Operation operation) {
+    std::string fullName = name + "<" + type + ">";
+    if (!filter.empty() && fullName.find(filter) == std::string::npos)
+        return;
+
+    for (int i = 0; i < warmup; i++)
+        operation(operations);
+
+    std::vector<Sample> measured(samples);
+
+    for (int i = 0; i < samples; i++) {
+        double t1 = getNanoseconds();
+        uint64_t c1 = getCycles();
+        operation(operations);
+        uint64_t c2 = getCycles();
+        double t2 = getNanoseconds();
+
+        measured[i].nanoseconds = (t2 - t1) / operations;
+        measured[i].cycles = double(c2 - c1) / operations;
+    }
+
+    std::vector<double> nanoseconds(samples);
+    for (int i = 0; i < samples; i++)
+        nanoseconds[i] = measured[i].nanoseconds;
+
+    double center = median(nanoseconds);
+    std::vector<double> deviations(samples);
+    for (int i = 0; i < samples; i++)
+        deviations[i] = std::fabs(nanoseconds[i] - center);
+
+    double limit = outlierThreshold * 1.4826 * median(deviations);
+    std::vector<double> keptNanoseconds;
+    std::vector<double> keptCycles;
+
+    for (int i = 0; i < samples; i++) {
+        if (deviations[i] > limit && limit > 0)
+            continue;
+
+        keptNanoseconds.push_back(measured[i].nanoseconds);
+        keptCycles.push_back(measured[i].cycles);
+    }
+
+    double mean = 0;
+    for (double value : keptNanoseconds)
+        mean += value;
+    mean /= keptNanoseconds.size();
+
+    double deviation = 0;
+    for (double value : keptNanoseconds)
+        deviation += (value - mean) * (value - mean);
+    deviation = std::sqrt(deviation / keptNanoseconds.size());
+
+    std::cout << "| " << std::left << std::setw(48) << fullName << " | " << std::right << std::fixed << std::setprecision(2);
+    std::cout << std::setw(8) << median(keptNanoseconds) << " | ";
+    std::cout << std::setw(8) << *std::min_element(keptNanoseconds.begin(), keptNanoseconds.end()) << " | ";
+    std::cout << std::setw(8) << deviation << " | ";
+    std::cout << std::setw(9) << median(keptCycles) << " | ";
+    std::cout << std::setw(8) << (samples - int(keptNanoseconds.size())) << " |" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+void MicroBenchmark::printHeader() {
+    std::cout << "+--------------------------------------------------+----------+----------+----------+-----------+----------+" << std::endl;
+    std::cout << "| benchmark                                        |  ns/op   |  min ns  |  std ns  | cycles/op | outliers |" << std::endl;
+    std::cout << "+--------------------------------------------------+----------+----------+----------+-----------+----------+" << std::endl;
+}
+
+void MicroBenchmark::printFooter() {
+    std::cout << "+--------------------------------------------------+----------+----------+----------+-----------+----------+" << std::endl;
+}
+
+double MicroBenchmark::median(std::vector<double> values) {
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    return values[middle];
+}
+
+template <typename Vector>
+std::vector<Vector> initVectors(int n, int minValue, int maxValue, std::mt19937 &generator) {
+    std::uniform_int_distribution<int> distribution(minValue, maxValue);
+    std::vector<Vector> vectors(POOL_SIZE);
+    std::vector<int> values(n);
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (i % 4 == 1) {
+            vectors[i] = -vectors[i - 1];
+            continue;
+        }
+
+        for (int j = 0; j < n; j++)
+            values[j] = distribution(generator);
+
+        vectors[i] = Vector(n, values.data());
+    }
+
+    return vectors;
+}
+
+template <typename T>
+void benchmarkTernaryVector(MicroBenchmark &benchmark, const std::string &type, int n, std::mt19937 &generator) {
+    std::vector<TernaryVector<T>> vectors = initVectors<TernaryVector<T>>(n, -1, 1, generator);
+
+    benchmark.run("TernaryVector::operator+=", type, [&vectors](size_t operations) {
+        TernaryVector<T> sum(vectors[0]);
+        for (size_t i = 0; i < operations; i++) {
+            sum += vectors[i % POOL_SIZE];
+            keep(sum);
+        }
+    });
+
+    benchmark.run("TernaryVector::limitSum", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].limitSum(vectors[(i + 1) % POOL_SIZE], true));
+    });
+
+    benchmark.run("TernaryVector::limitSub", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].limitSub(vectors[(i + 1) % POOL_SIZE], true));
+    });
+
+    benchmark.run("TernaryVector::positiveFirstNonZeroSub", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].positiveFirstNonZeroSub(vectors[(i + 1) % POOL_SIZE]));
+    });
+
+    benchmark.run("TernaryVector::compare", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].compare(vectors[(i + 1) % POOL_SIZE]));
+    });
+
+    benchmark.run("TernaryVector::nonZeroCount", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].nonZeroCount());
+    });
+}
+
+template <typename T>
+void benchmarkMod3Vector(MicroBenchmark &benchmark, const std::string &type, int n, std::mt19937 &generator) {
+    std::vector<Mod3Vector<T>> vectors = initVectors<Mod3Vector<T>>(n, 0, 2, generator);
+
+    benchmark.run("Mod3Vector::operator+=", type, [&vectors](size_t operations) {
+        Mod3Vector<T> sum(vectors[0]);
+        for (size_t i = 0; i < operations; i++) {
+            sum += vectors[i % POOL_SIZE];
+            keep(sum);
+        }
+    });
+
+    benchmark.run("Mod3Vector::operator-=", type, [&vectors](size_t operations) {
+        Mod3Vector<T> sum(vectors[0]);
+        for (size_t i = 0; i < operations; i++) {
+            sum -= vectors[i % POOL_SIZE];
+            keep(sum);
+        }
+    });
+
+    benchmark.run("Mod3Vector::compare", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].compare(vectors[(i + 1) % POOL_SIZE]));
+    });
+
+    benchmark.run("Mod3Vector::nonZeroCount", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].nonZeroCount());
+    });
+}
+
+template <typename T>
+void benchmarkBitVector(MicroBenchmark &benchmark, const std::string &type, std::mt19937 &generator) {
+    std::vector<T> vectors(POOL_SIZE);
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        if (i % 4 == 1) {
+            vectors[i] = vectors[i - 1];
+            continue;
+        }
+
+        for (int bit = 0; bit < int(sizeof(T) * 8); bit++)
+            if (generator() & 1)
+                vectors[i] |= T(1) << bit;
+    }
+
+    benchmark.run("BitVector::operator^", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE] ^ vectors[(i + 1) % POOL_SIZE]);
+    });
+
+    benchmark.run("BitVector::operator&", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE] & vectors[(i + 1) % POOL_SIZE]);
+    });
+
+    benchmark.run("BitVector::operator-", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(-vectors[i % POOL_SIZE]);
+    });
+
+    benchmark.run("BitVector::operator<<", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE] << int(i % 97));
+    });
+
+    benchmark.run("BitVector::operator==", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE] == vectors[(i + 1) % POOL_SIZE]);
+    });
+
+    benchmark.run("BitVector::operator!", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(!vectors[i % POOL_SIZE]);
+    });
+
+    benchmark.run("BitVector::popcount", type, [&vectors](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(vectors[i % POOL_SIZE].popcount());
+    });
+}
+
+void benchmarkFlipSet(MicroBenchmark &benchmark, int rank, std::mt19937 &generator) {
+    std::uniform_int_distribution<uint32_t> distribution(0, rank - 1);
+    std::vector<uint32_t> indices(POOL_SIZE * 2);
+    FlipSet flips;
+
+    for (int i = 0; i < rank * 2; i++) {
+        uint32_t index1 = distribution(generator);
+        uint32_t index2 = distribution(generator);
+
+        if (index1 != index2 && !flips.contains(index1, index2))
+            flips.add(index1, index2);
+    }
+
+    for (size_t i = 0; i < indices.size(); i++)
+        indices[i] = distribution(generator);
+
+    std::string type = "rank" + std::to_string(rank);
+
+    benchmark.run("FlipSet::contains", type, [&flips, &indices](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            keep(flips.contains(indices[(2 * i) % indices.size()], indices[(2 * i + 1) % indices.size()]));
+    });
+
+    benchmark.run("FlipSet::add+remove", type, [&flips, &indices](size_t operations) {
+        for (size_t i = 0; i < operations; i++) {
+            uint32_t index1 = indices[(2 * i) % indices.size()];
+            uint32_t index2 = indices[(2 * i + 1) % indices.size()];
+            flips.add(index1, index2);
+            flips.remove(index1, index2);
+        }
+
+        keep(flips);
+    });
+
+    benchmark.run("FlipSet::iterate", type, [&flips](size_t operations) {
+        size_t size = flips.size();
+        for (size_t i = 0; i < operations; i++) {
+            size_t index = i % size;
+            keep(flips.index1(index) + flips.index2(index));
+        }
+    });
+}
+
+int main(int argc, char **argv) {
+    ArgParser parser("microbenchmark", "Measure per-operation cost of vector, bit vector and flip set primitives");
+
+    parser.add("--filter", "-f", ArgType::String, "Run only benchmarks which names contain the substring");
+    parser.add("--warmup", ArgType::UInt, "Number of warmup samples", "3");
+    parser.add("--samples", "-s", ArgType::Natural, "Number of measured samples", "30");
+    parser.add("--operations", ArgType::Natural, "Number of operations per sample", "100K");
+    parser.add("--outlier-threshold", ArgType::Real, "Samples farther than threshold * MAD from the median are rejected", "3");
+    parser.add("--seed", ArgType::UInt, "Random seed of the operands", "42");
+
+    if (!parser.parse(argc, argv))
+        return -1;
+
+    std::string filter = parser.isSet("--filter") ? parser["--filter"] : "";
+    int warmup = std::stoi(parser["--warmup"]);
+    int samples = std::stoi(parser["--samples"]);
+    size_t operations = parseNatural(parser["--operations"]);
+    double outlierThreshold = std::stod(parser["--outlier-threshold"]);
+    std::mt19937 generator(std::stoi(parser["--seed"]));
+
+    std::cout << "Micro benchmark parameters:" << std::endl;
+    std::cout << "- backend: " << getBitVectorBackend() << std::endl;
+    std::cout << "- timer: clock_gettime" << (getCycles() ? " + rdtsc" : "") << std::endl;
+    std::cout << "- warmup: " << warmup << std::endl;
+    std::cout << "- samples: " << samples << std::endl;
+    std::cout << "- operations per sample: " << prettyInt(operations) << std::endl;
+    std::cout << "- outlier threshold: " << outlierThreshold << " MAD" << std::endl;
+    std::cout << std::endl;
+
+    MicroBenchmark benchmark(filter, warmup, samples, operations, outlierThreshold);
+    MicroBenchmark::printHeader();
+
+    benchmarkTernaryVector<uint16_t>(benchmark, "uint16", 16, generator);
+    benchmarkTernaryVector<uint32_t>(benchmark, "uint32", 32, generator);
+    benchmarkTernaryVector<uint64_t>(benchmark, "uint64", 64, generator);
+    benchmarkTernaryVector<__uint128_t>(benchmark, "uint128", 128, generator);
+    benchmarkTernaryVector<uint256_t>(benchmark, "uint256", 256, generator);
+    benchmarkTernaryVector<uint512_t>(benchmark, "uint512", 512, generator);
+    benchmarkTernaryVector<uint1024_t>(benchmark, "uint1024", 1024, generator);
+
+    benchmarkMod3Vector<uint16_t>(benchmark, "uint16", 16, generator);
+    benchmarkMod3Vector<uint32_t>(benchmark, "uint32", 32, generator);
+    benchmarkMod3Vector<uint64_t>(benchmark, "uint64", 64, generator);
+    benchmarkMod3Vector<__uint128_t>(benchmark, "uint128", 128, generator);
+    benchmarkMod3Vector<uint256_t>(benchmark, "uint256", 256, generator);
+    benchmarkMod3Vector<uint512_t>(benchmark, "uint512", 512, generator);
+    benchmarkMod3Vector<uint1024_t>(benchmark, "uint1024", 1024, generator);
+
+    benchmarkBitVector<uint256_t>(benchmark, "uint256", generator);
+    benchmarkBitVector<uint512_t>(benchmark, "uint512", generator);
+    benchmarkBitVector<uint1024_t>(benchmark, "uint1024", generator);
+
+    benchmarkFlipSet(benchmark, 64, generator);
+    benchmarkFlipSet(benchmark, 512, generator);
+
+    MicroBenchmark::printFooter();
+    return 0;
+}
@@ -30,6 +30,7 @@ int runSchemeOptimizer(const ArgParser &parser) {
 
     int topCount = std::stoi(parser["--top-count"]);
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     bool maximizeFlips = parser.isSet("--maximize-flips");
     double copyBestProbability = std::stod(parser["--copy-best-probability"]);
     int maxNoImprovements = std::stoi(parser["--max-no-improvements"]);
@@ -54,13 +55,14 @@ int runSchemeOptimizer(const ArgParser &parser) {
     std::cout << std::endl;
     std::cout << "- top count: " << topCount << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- copy best probability: " << copyBestProbability << std::endl;
     std::cout << "- maximize flips: " << (maximizeFlips ? "yes" : "no") << std::endl;
     std::cout << "- max no improvements: " << maxNoImprovements << std::endl;
     std::cout << "- max matrix elements: " << maxMatrixElements << " (uint" << maxMatrixElements << "_t)" << std::endl;
     std::cout << std::endl;
 
-    SchemeOptimizer<Scheme<T>> optimizer(count, outputPath, threads, flipIterations, plusProbability, plusDiff, sandwichingProbability, seed, copyBestProbability, maximizeFlips, topCount, format);
+    SchemeOptimizer<Scheme<T>> optimizer(count, outputPath, threads, flipIterations, plusProbability, plusDiff, sandwichingProbability, seed, generatorType, copyBestProbability, maximizeFlips, topCount, format);
 
     if (!optimizer.initializeFromFile(inputPath, parser.isSet("--multiple"), !parser.isSet("--no-verify")))
         return -1;
@@ -90,7 +92,13 @@ int runSchemeOptimizerSizes(const ArgParser &parser) {
     if (maxMatrixElements <= 128)
         return runSchemeOptimizer<Scheme, __uint128_t>(parser);
 
-    return runSchemeOptimizer<Scheme, uint256_t>(parser);
+    if (maxMatrixElements <= 256)
+        return runSchemeOptimizer<Scheme, uint256_t>(parser);
+
+    if (maxMatrixElements <= 512)
+        return runSchemeOptimizer<Scheme, uint512_t>(parser);
+
+    return runSchemeOptimizer<Scheme, uint1024_t>(parser);
 }
 
 int main(int argc, char **argv) {
@@ -116,6 +124,7 @@ int main(int argc, char **argv) {
     parser.addSection("Other parameters");
     parser.add("--top-count", ArgType::Natural, "Number of top schemes to report", "10");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
     parser.add("--maximize-flips", ArgType::Flag, "Maximize number of potential flips");
     parser.add("--copy-best-probability", ArgType::Real, "Probability to replace scheme with best scheme after improvement, from 0.0 to 1.0", "0.5");
     parser.add("--max-no-improvements", ArgType::Natural, "Maximum iterations without improvement before termination", "3");
@@ -34,6 +34,7 @@ bool runSandwichFlip(const ArgParser &parser) {
     size_t maxImprovements = parseNatural(parser["--max-improvements"]);
     size_t maxNoImprovements = parseNatural(parser["--max-no-improvements"]);
     int seed = std::stoi(parser["--seed"]);
+    std::string generatorType = parser["--random-generator"];
     if (seed == 0)
         seed = time(0);
 
@@ -53,6 +54,7 @@ bool runSandwichFlip(const ArgParser &parser) {
 
     std::cout << "Other parameters:" << std::endl;
     std::cout << "- seed: " << seed << std::endl;
+    std::cout << "- random generator: " << generatorType << std::endl;
     std::cout << "- format: " << format << std::endl;
     std::cout << "- max no improvements: " << prettyInt(maxNoImprovements) << std::endl;
     std::cout << "- max improvements: " << maxImprovements << std::endl;
@@ -64,7 +66,7 @@ bool runSandwichFlip(const ArgParser &parser) {
         return false;
     }
 
-    SandwichFlipOptimizer optimizer(count, outputPath, threads, sandwichFlipParameters, sandwichingParameters, scaleParameters, plusParameters, seed, maxImprovements, format);
+    SandwichFlipOptimizer optimizer(count, outputPath, threads, sandwichFlipParameters, sandwichingParameters, scaleParameters, plusParameters, seed, generatorType, maxImprovements, format);
     if (!optimizer.initializeFromFile(inputPath, !parser.isSet("--no-verify"), parser.isSet("--integer")))
         return false;
 
@@ -92,6 +94,7 @@ int main(int argc, char *argv[]) {
     parser.add("--max-improvements", ArgType::Natural, "Number of last improved schemes", "8");
     parser.add("--max-no-improvements", ArgType::Natural, "Maximum number of iterations without improvement", "10M");
     parser.add("--seed", ArgType::Natural, "Random seed, 0 uses time-based seed", "0");
+    parser.addChoices("--random-generator", ArgType::String, "Random generator of runners", {"xoshiro", "mt19937"}, "xoshiro");
     parser.addChoices("--format", "-f", ArgType::String, "Output format for saved schemes", {"json", "txt"}, "txt");
 
     if (!parser.parse(argc, argv))
@@ -99,7 +99,7 @@ void BinaryMatrix::sandwich(const BinaryMatrix &left, const BinaryMatrix &right)
     }
 }
 
-void BinaryMatrix::random(std::mt19937 &generator) {
+void BinaryMatrix::random(RandomGenerator &generator) {
     if (generator() % 10) {
         identity();
 
@@ -121,7 +121,7 @@ void BinaryMatrix::random(std::mt19937 &generator) {
     }
 }
 
-void BinaryMatrix::randomInvertible(BinaryMatrix &inverse, std::mt19937 &generator) {
+void BinaryMatrix::randomInvertible(BinaryMatrix &inverse, RandomGenerator &generator) {
     do {
         random(generator);
     } while (!invertible(inverse));
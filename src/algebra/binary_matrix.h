@@ -4,6 +4,7 @@
 #include <vector>
 #include <random>
 #include <cstdint>
+#include "../entities/random_generator.h"
 
 class BinaryMatrix {
     int rows;
@@ -23,6 +24,6 @@ public:
 
     void swapRows(int row1, int row2);
     void sandwich(const BinaryMatrix &left, const BinaryMatrix &right);
-    void random(std::mt19937 &generator);
-    void randomInvertible(BinaryMatrix &inverse, std::mt19937 &generator);
+    void random(RandomGenerator &generator);
+    void randomInvertible(BinaryMatrix &inverse, RandomGenerator &generator);
 };
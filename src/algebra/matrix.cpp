@@ -216,7 +216,7 @@ void Matrix::sandwich(const Matrix &left, const Matrix &right) {
     }
 }
 
-void Matrix::random(int min, int max, int denominator, std::mt19937 &generator) {
+void Matrix::random(int min, int max, int denominator, RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(min, max);
 
     if (generator() % 10) {
@@ -7,6 +7,7 @@
 #include <cstdint>
 
 #include "fraction.h"
+#include "../entities/random_generator.h"
 
 class Matrix {
     int rows;
@@ -39,7 +40,7 @@ public:
     void divideRow(int row, const Fraction &divider, int column = 0);
     void subtractRow(int row1, int row2, const Fraction &value, int column = 0);
     void sandwich(const Matrix &left, const Matrix &right);
-    void random(int min, int max, int denominator, std::mt19937 &generator);
+    void random(int min, int max, int denominator, RandomGenerator &generator);
     void diagonal(const Fraction &value);
 
     bool toRing(int ring);
@@ -0,0 +1,84 @@
+#include "background_writer.h"
+
+BackgroundWriter::BackgroundWriter(int threads, size_t capacity) {
+    this->capacity = capacity;
+    this->active = 0;
+    this->stalls = 0;
+    this->stopping = false;
+
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(&BackgroundWriter::work, this);
+}
+
+BackgroundWriter::~BackgroundWriter() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    hasTask.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void BackgroundWriter::submit(std::function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (tasks.size() >= capacity) {
+        stalls++;
+        hasSpace.wait(lock, [this] { return tasks.size() < capacity; });
+    }
+
+    tasks.emplace_back(std::move(task));
+    lock.unlock();
+    hasTask.notify_one();
+}
+
+void BackgroundWriter::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    isIdle.wait(lock, [this] { return tasks.empty() && active == 0; });
+}
+
+size_t BackgroundWriter::pending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size() + active;
+}
+
+size_t BackgroundWriter::getStalls() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stalls;
+}
+
+void BackgroundWriter::work() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(mutex);
+        hasTask.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+        if (tasks.empty())
+            return;
+
+        std::function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        active++;
+        lock.unlock();
+        hasSpace.notify_one();
+
+        task();
+
+        lock.lock();
+        active--;
+        bool idle = tasks.empty() && active == 0;
+        lock.unlock();
+
+        if (idle)
+            isIdle.notify_all();
+    }
+}
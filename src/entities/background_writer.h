@@ -0,0 +1,33 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class BackgroundWriter {
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable hasTask;
+    std::condition_variable hasSpace;
+    std::condition_variable isIdle;
+    size_t capacity;
+    size_t active;
+    size_t stalls;
+    bool stopping;
+public:
+    BackgroundWriter(int threads, size_t capacity);
+    ~BackgroundWriter();
+
+    void submit(std::function<void()> task);
+    void wait();
+
+    size_t pending();
+    size_t getStalls();
+private:
+    void work();
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+void writeBinary(std::ostream &os, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "writeBinary requires trivially copyable type");
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readBinary(std::istream &is, T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "readBinary requires trivially copyable type");
+    return bool(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+// lengths come from files, so they are checked against the bytes left in the stream before anything is allocated
+inline bool checkBinarySize(std::istream &is, uint64_t size, uint64_t itemSize) {
+    const uint64_t maxUnseekableSize = uint64_t(1) << 30;
+
+    std::streampos position = is.tellg();
+    if (position < 0)
+        return size <= maxUnseekableSize / itemSize;
+
+    is.seekg(0, std::ios::end);
+    std::streampos end = is.tellg();
+    is.seekg(position);
+
+    return end >= position && size <= uint64_t(end - position) / itemSize;
+}
+
+template <typename T>
+void writeBinary(std::ostream &os, const std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value, "writeBinary requires trivially copyable type");
+    writeBinary(os, uint64_t(values.size()));
+    os.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+bool readBinary(std::istream &is, std::vector<T> &values) {
+    static_assert(std::is_trivially_copyable<T>::value, "readBinary requires trivially copyable type");
+    uint64_t size;
+    if (!readBinary(is, size) || !checkBinarySize(is, size, sizeof(T)))
+        return false;
+
+    values.resize(size);
+    return bool(is.read(reinterpret_cast<char *>(values.data()), size * sizeof(T)));
+}
+
+inline void writeBinary(std::ostream &os, const std::string &value) {
+    writeBinary(os, uint64_t(value.size()));
+    os.write(value.data(), value.size());
+}
+
+inline bool readBinary(std::istream &is, std::string &value) {
+    uint64_t size;
+    if (!readBinary(is, size) || !checkBinarySize(is, size, 1))
+        return false;
+
+    value.resize(size);
+    return bool(is.read(&value[0], size));
+}
+
+template <typename T>
+void writeBlob(std::vector<uint8_t> &blob, const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "writeBlob requires trivially copyable type");
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    blob.insert(blob.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+void readBlob(const uint8_t *&data, T &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "readBlob requires trivially copyable type");
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+}
+
+// only the lowest bits of a value are stored, integer types are little-endian, so bit i of a value is bit i % 8 of byte i / 8
+template <typename T>
+void writeBlobBits(std::vector<uint8_t> &blob, size_t &position, const T &value, int bits) {
+    static_assert(std::is_trivially_copyable<T>::value, "writeBlobBits requires trivially copyable type");
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+
+    for (int i = 0; i < bits; i += 8) {
+        int count = std::min(8, bits - i);
+        uint8_t byte = bytes[i / 8] & uint8_t((1 << count) - 1);
+        int shift = position % 8;
+
+        if (shift == 0) {
+            blob.push_back(byte);
+        }
+        else {
+            blob.back() |= uint8_t(byte << shift);
+
+            if (shift + count > 8)
+                blob.push_back(byte >> (8 - shift));
+        }
+
+        position += count;
+    }
+}
+
+template <typename T>
+void readBlobBits(const uint8_t *data, size_t &position, T &value, int bits) {
+    static_assert(std::is_trivially_copyable<T>::value, "readBlobBits requires trivially copyable type");
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(&value);
+    memset(bytes, 0, sizeof(T));
+
+    for (int i = 0; i < bits; i += 8) {
+        int count = std::min(8, bits - i);
+        int shift = position % 8;
+        unsigned window = data[position / 8] >> shift;
+
+        if (shift + count > 8)
+            window |= unsigned(data[position / 8 + 1]) << (8 - shift);
+
+        bytes[i / 8] = uint8_t(window & ((1u << count) - 1));
+        position += count;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include "bit_vector.hpp"
+
+inline uint64_t mixBits(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+template <typename T>
+uint64_t hashBits(const T &value) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int shift = 0; shift < int(sizeof(T) * 8); shift += 64)
+        hash = mixBits(hash ^ uint64_t(value >> shift));
+
+    return hash;
+}
+
+template <int N>
+uint64_t hashBits(const BitVector<N> &value) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < N / 64; i++)
+        hash = mixBits(hash ^ value.word(i));
+
+    return hash;
+}
+
+template <typename T>
+uint64_t foldBits(uint64_t hash, const T &value) {
+    for (int shift = 0; shift < int(sizeof(T) * 8); shift += 64)
+        hash = (hash ^ uint64_t(value >> shift)) * 0x9E3779B97F4A7C15ULL;
+
+    return hash ^ (hash >> 32);
+}
+
+template <int N>
+uint64_t foldBits(uint64_t hash, const BitVector<N> &value) {
+    for (int i = 0; i < N / 64; i++)
+        hash = (hash ^ value.word(i)) * 0x9E3779B97F4A7C15ULL;
+
+    return hash ^ (hash >> 32);
+}
@@ -0,0 +1,30 @@
+#include "bit_vector.hpp"
+
+std::string getBitVectorBackend() {
+#if defined(__AVX512F__)
+    return "avx512";
+#elif defined(__AVX2__)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+static bool checkBitVectorBackend() {
+#if defined(__AVX512F__)
+    bool supported = __builtin_cpu_supports("avx512f");
+#elif defined(__AVX2__)
+    bool supported = __builtin_cpu_supports("avx2");
+#else
+    bool supported = true;
+#endif
+
+    if (!supported) {
+        std::cerr << "Binary was built with " << getBitVectorBackend() << " support, but this CPU does not provide it. Rebuild with make SIMD=none" << std::endl;
+        std::exit(1);
+    }
+
+    return supported;
+}
+
+static const bool bitVectorBackendSupported = checkBitVectorBackend();
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cinttypes>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+template <int N>
+class BitVector {
+    static_assert(N % 64 == 0, "BitVector size must be a multiple of 64");
+    static constexpr int WORDS = N / 64;
+
+    uint64_t words[WORDS];
+public:
+    BitVector();
+    BitVector(int value);
+    BitVector(unsigned int value);
+
+    BitVector operator<<(int n) const;
+    BitVector operator>>(int n) const;
+
+    BitVector operator&(const BitVector &other) const;
+    BitVector& operator&=(const BitVector &other);
+
+    BitVector operator&(int value) const;
+
+    BitVector operator|(const BitVector &other) const;
+    BitVector& operator|=(const BitVector &other);
+
+    BitVector operator^(const BitVector &other) const;
+    BitVector& operator^=(const BitVector &other);
+
+    BitVector operator~() const;
+    BitVector operator-() const;
+
+    bool operator==(const BitVector &other) const;
+    bool operator!=(const BitVector &other) const;
+
+    bool operator!() const;
+
+    int popcount() const;
+    uint64_t word(int index) const;
+
+    operator bool() const;
+    operator int() const;
+    operator uint8_t() const;
+    operator uint64_t() const;
+private:
+    static bool isZero(const uint64_t *words);
+};
+
+typedef BitVector<256> uint256_t;
+typedef BitVector<512> uint512_t;
+typedef BitVector<1024> uint1024_t;
+
+std::string getBitVectorBackend();
+
+template <int N>
+BitVector<N>::BitVector() {
+    for (int i = 0; i < WORDS; i++)
+        words[i] = 0;
+}
+
+template <int N>
+BitVector<N>::BitVector(int value) : BitVector() {
+    words[0] = uint64_t(value);
+}
+
+template <int N>
+BitVector<N>::BitVector(unsigned int value) : BitVector() {
+    words[0] = value;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator<<(int n) const {
+    BitVector<N> result;
+
+    if (n >= N)
+        return result;
+
+    int wordShift = n / 64;
+    int bitShift = n % 64;
+
+    if (bitShift == 0) {
+        for (int i = wordShift; i < WORDS; i++)
+            result.words[i] = words[i - wordShift];
+
+        return result;
+    }
+
+    result.words[wordShift] = words[0] << bitShift;
+
+    for (int i = wordShift + 1; i < WORDS; i++)
+        result.words[i] = (words[i - wordShift] << bitShift) | (words[i - wordShift - 1] >> (64 - bitShift));
+
+    return result;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator>>(int n) const {
+    BitVector<N> result;
+
+    if (n >= N)
+        return result;
+
+    int wordShift = n / 64;
+    int bitShift = n % 64;
+
+    if (bitShift == 0) {
+        for (int i = wordShift; i < WORDS; i++)
+            result.words[i - wordShift] = words[i];
+
+        return result;
+    }
+
+    for (int i = wordShift; i < WORDS - 1; i++)
+        result.words[i - wordShift] = (words[i] >> bitShift) | (words[i + 1] << (64 - bitShift));
+
+    result.words[WORDS - 1 - wordShift] = words[WORDS - 1] >> bitShift;
+    return result;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator&(const BitVector<N> &other) const {
+    BitVector<N> result(*this);
+    result &= other;
+    return result;
+}
+
+template <int N>
+BitVector<N>& BitVector<N>::operator&=(const BitVector<N> &other) {
+    for (int i = 0; i < WORDS; i++)
+        words[i] &= other.words[i];
+
+    return *this;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator&(int value) const {
+    BitVector<N> result;
+    result.words[0] = words[0] & uint64_t(value);
+    return result;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator|(const BitVector<N> &other) const {
+    BitVector<N> result(*this);
+    result |= other;
+    return result;
+}
+
+template <int N>
+BitVector<N>& BitVector<N>::operator|=(const BitVector<N> &other) {
+    for (int i = 0; i < WORDS; i++)
+        words[i] |= other.words[i];
+
+    return *this;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator^(const BitVector<N> &other) const {
+    BitVector<N> result(*this);
+    result ^= other;
+    return result;
+}
+
+template <int N>
+BitVector<N>& BitVector<N>::operator^=(const BitVector<N> &other) {
+    for (int i = 0; i < WORDS; i++)
+        words[i] ^= other.words[i];
+
+    return *this;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator~() const {
+    BitVector<N> result;
+
+    for (int i = 0; i < WORDS; i++)
+        result.words[i] = ~words[i];
+
+    return result;
+}
+
+template <int N>
+BitVector<N> BitVector<N>::operator-() const {
+    BitVector<N> result;
+    uint64_t carry = 1;
+
+    for (int i = 0; i < WORDS; i++) {
+        result.words[i] = ~words[i] + carry;
+        carry &= result.words[i] == 0;
+    }
+
+    return result;
+}
+
+template <int N>
+bool BitVector<N>::operator==(const BitVector<N> &other) const {
+    if (words[0] != other.words[0])
+        return false;
+
+    uint64_t diff[WORDS];
+
+    for (int i = 0; i < WORDS; i++)
+        diff[i] = words[i] ^ other.words[i];
+
+    return isZero(diff);
+}
+
+template <int N>
+bool BitVector<N>::operator!=(const BitVector<N> &other) const {
+    return !(*this == other);
+}
+
+template <int N>
+bool BitVector<N>::operator!() const {
+    return isZero(words);
+}
+
+template <int N>
+int BitVector<N>::popcount() const {
+    int count = 0;
+
+    for (int i = 0; i < WORDS; i++)
+        count += __builtin_popcountll(words[i]);
+
+    return count;
+}
+
+template <int N>
+uint64_t BitVector<N>::word(int index) const {
+    return words[index];
+}
+
+template <int N>
+BitVector<N>::operator bool() const {
+    return !isZero(words);
+}
+
+template <int N>
+BitVector<N>::operator int() const {
+    return int(words[0]);
+}
+
+template <int N>
+BitVector<N>::operator uint8_t() const {
+    return uint8_t(words[0]);
+}
+
+template <int N>
+BitVector<N>::operator uint64_t() const {
+    return words[0];
+}
+
+template <int N>
+bool BitVector<N>::isZero(const uint64_t *words) {
+#if defined(__AVX512F__)
+    if (N % 512 == 0) {
+        __m512i acc = _mm512_loadu_si512(words);
+
+        for (int i = 8; i < WORDS; i += 8)
+            acc = _mm512_or_si512(acc, _mm512_loadu_si512(words + i));
+
+        return _mm512_test_epi64_mask(acc, acc) == 0;
+    }
+#endif
+#if defined(__AVX2__)
+    if (N % 256 == 0) {
+        __m256i acc = _mm256_loadu_si256((const __m256i *) words);
+
+        for (int i = 4; i < WORDS; i += 4)
+            acc = _mm256_or_si256(acc, _mm256_loadu_si256((const __m256i *) (words + i)));
+
+        return _mm256_testz_si256(acc, acc);
+    }
+#endif
+    uint64_t acc = 0;
+
+    for (int i = 0; i < WORDS; i++)
+        acc |= words[i];
+
+    return acc == 0;
+}
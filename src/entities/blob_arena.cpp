@@ -0,0 +1,88 @@
+#include "blob_arena.h"
+
+BlobArena::BlobArena(size_t slabSize) {
+    this->slabSize = slabSize;
+    this->used = 0;
+}
+
+size_t BlobArena::size() const {
+    return blobs.size();
+}
+
+size_t BlobArena::memoryUsage() const {
+    return sizeof(BlobArena) + blobs.capacity() * sizeof(BlobLocation) + slabs.capacity() * (sizeof(std::unique_ptr<uint8_t[]>) + sizeof(size_t)) + getAllocated();
+}
+
+size_t BlobArena::push(const std::vector<uint8_t> &blob) {
+    BlobLocation location = allocate(blob.size());
+    memcpy(slabs[location.slab].get() + location.offset, blob.data(), blob.size());
+    blobs.push_back(location);
+    return blobs.size() - 1;
+}
+
+void BlobArena::set(size_t index, const std::vector<uint8_t> &blob) {
+    BlobLocation &location = blobs[index];
+
+    if (align(location.size) != align(blob.size())) {
+        release(location);
+        location = allocate(blob.size());
+    }
+
+    location.size = blob.size();
+    memcpy(slabs[location.slab].get() + location.offset, blob.data(), blob.size());
+}
+
+const uint8_t* BlobArena::get(size_t index) const {
+    const BlobLocation &location = blobs[index];
+    return slabs[location.slab].get() + location.offset;
+}
+
+size_t BlobArena::getSize(size_t index) const {
+    return blobs[index].size;
+}
+
+void BlobArena::clear() {
+    slabs.clear();
+    slabSizes.clear();
+    blobs.clear();
+    freeSlots.clear();
+    used = 0;
+}
+
+size_t BlobArena::getAllocated() const {
+    size_t total = 0;
+
+    for (size_t size : slabSizes)
+        total += size;
+
+    return total;
+}
+
+uint32_t BlobArena::align(size_t size) {
+    return uint32_t((size + 7) & ~size_t(7));
+}
+
+BlobLocation BlobArena::allocate(size_t size) {
+    auto it = freeSlots.find(align(size));
+    if (it != freeSlots.end() && !it->second.empty()) {
+        BlobLocation location = it->second.back();
+        it->second.pop_back();
+        location.size = size;
+        return location;
+    }
+
+    if (slabs.empty() || used + size > slabSizes.back()) {
+        size_t allocated = std::max(std::min(slabSize, std::max(BLOB_ARENA_MIN_SLAB_SIZE, getAllocated())), size);
+        slabs.emplace_back(new uint8_t[allocated]);
+        slabSizes.push_back(allocated);
+        used = 0;
+    }
+
+    BlobLocation location = {uint32_t(slabs.size() - 1), uint32_t(used), uint32_t(size)};
+    used += align(size);
+    return location;
+}
+
+void BlobArena::release(const BlobLocation &location) {
+    freeSlots[align(location.size)].push_back(location);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+const size_t BLOB_ARENA_SLAB_SIZE = 1 << 20;
+const size_t BLOB_ARENA_MIN_SLAB_SIZE = 1 << 12;
+
+struct BlobLocation {
+    uint32_t slab;
+    uint32_t offset;
+    uint32_t size;
+};
+
+class BlobArena {
+    std::vector<std::unique_ptr<uint8_t[]>> slabs;
+    std::vector<size_t> slabSizes;
+    std::vector<BlobLocation> blobs;
+    std::unordered_map<uint32_t, std::vector<BlobLocation>> freeSlots; // released slots by aligned size
+    size_t slabSize;
+    size_t used;
+public:
+    BlobArena(size_t slabSize = BLOB_ARENA_SLAB_SIZE);
+
+    size_t size() const;
+    size_t memoryUsage() const;
+
+    size_t push(const std::vector<uint8_t> &blob);
+    void set(size_t index, const std::vector<uint8_t> &blob);
+    const uint8_t* get(size_t index) const;
+    size_t getSize(size_t index) const;
+    void clear();
+private:
+    size_t getAllocated() const;
+    static uint32_t align(size_t size);
+    BlobLocation allocate(size_t size);
+    void release(const BlobLocation &location);
+};
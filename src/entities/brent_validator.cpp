@@ -0,0 +1,166 @@
+#include "brent_validator.h"
+
+BrentValidator::BrentValidator(int n1, int n2, int n3, int rank, int modulo) {
+    dimension[0] = n1;
+    dimension[1] = n2;
+    dimension[2] = n3;
+
+    for (int i = 0; i < 3; i++)
+        elements[i] = dimension[i] * dimension[(i + 1) % 3];
+
+    this->rank = rank;
+    this->words = (rank + 63) / 64;
+    this->modulo = modulo;
+
+    for (int i = 0; i < 3; i++) {
+        nonZero[i].assign(elements[i] * words, 0);
+        negative[i].assign(elements[i] * words, 0);
+    }
+}
+
+void BrentValidator::set(int matrix, int index, int element, int value) {
+    if (modulo) {
+        value = ((value % modulo) + modulo) % modulo;
+
+        if (modulo == 3 && value == 2)
+            value = -1;
+    }
+
+    if (value == 0)
+        return;
+
+    uint64_t mask = uint64_t(1) << (index % 64);
+    int offset = element * words + index / 64;
+
+    nonZero[matrix][offset] |= mask;
+
+    if (value < 0)
+        negative[matrix][offset] |= mask;
+}
+
+bool BrentValidator::validate() const {
+    std::vector<uint64_t> pairNonZero(words);
+    std::vector<uint64_t> pairNegative(words);
+
+    for (int i = 0; i < elements[0]; i++)
+        for (int j = 0; j < elements[1]; j++)
+            if (!validatePair(i, j, pairNonZero.data(), pairNegative.data()))
+                return false;
+
+    return true;
+}
+
+bool BrentValidator::validateParallel() const {
+    bool valid = true;
+
+    #pragma omp parallel reduction(&&: valid)
+    {
+        std::vector<uint64_t> pairNonZero(words);
+        std::vector<uint64_t> pairNegative(words);
+
+        #pragma omp for collapse(2) schedule(dynamic, 8)
+        for (int i = 0; i < elements[0]; i++)
+            for (int j = 0; j < elements[1]; j++)
+                valid = valid && validatePair(i, j, pairNonZero.data(), pairNegative.data());
+    }
+
+    return valid;
+}
+
+bool BrentValidator::validatePair(int i, int j, uint64_t *pairNonZero, uint64_t *pairNegative) const {
+    const uint64_t *nonZeroI = nonZero[0].data() + i * words;
+    const uint64_t *nonZeroJ = nonZero[1].data() + j * words;
+    const uint64_t *negativeI = negative[0].data() + i * words;
+    const uint64_t *negativeJ = negative[1].data() + j * words;
+
+    for (int w = 0; w < words; w++) {
+        pairNonZero[w] = nonZeroI[w] & nonZeroJ[w];
+        pairNegative[w] = negativeI[w] ^ negativeJ[w];
+    }
+
+    int i1 = i / dimension[1];
+    int i2 = i % dimension[1];
+    int j1 = j / dimension[2];
+    int j2 = j % dimension[2];
+    int targetK = i2 == j1 ? j2 * dimension[0] + i1 : -1;
+
+    for (int k = 0; k < elements[2]; k++) {
+        int count, negativeCount;
+        countProducts(pairNonZero, pairNegative, k, count, negativeCount);
+
+        if (!checkSum(count, negativeCount, k == targetK))
+            return false;
+    }
+
+    return true;
+}
+
+bool BrentValidator::checkSum(int count, int negativeCount, int target) const {
+    if (modulo == 2)
+        return count % 2 == target;
+
+    int sum = count - 2 * negativeCount;
+
+    if (modulo == 3)
+        return ((sum % 3) + 3) % 3 == target;
+
+    return sum == target;
+}
+
+static inline int popcount64(uint64_t value) {
+#ifdef __POPCNT__
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return int((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+#ifdef __AVX2__
+static inline __m256i popcount256(__m256i v) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    __m256i low = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, lowMask));
+    __m256i high = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask));
+    return _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256());
+}
+
+static inline int sum256(__m256i v) {
+    return int(_mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1) + _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3));
+}
+#endif
+
+void BrentValidator::countProducts(const uint64_t *pairNonZero, const uint64_t *pairNegative, int k, int &count, int &negativeCount) const {
+    const uint64_t *nonZeroK = nonZero[2].data() + k * words;
+    const uint64_t *negativeK = negative[2].data() + k * words;
+
+    count = 0;
+    negativeCount = 0;
+    int w = 0;
+
+#ifdef __AVX2__
+    __m256i counts = _mm256_setzero_si256();
+    __m256i negativeCounts = _mm256_setzero_si256();
+
+    for (; w + 4 <= words; w += 4) {
+        __m256i values = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (pairNonZero + w)), _mm256_loadu_si256((const __m256i *) (nonZeroK + w)));
+        __m256i signs = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (pairNegative + w)), _mm256_loadu_si256((const __m256i *) (negativeK + w)));
+        counts = _mm256_add_epi64(counts, popcount256(values));
+        negativeCounts = _mm256_add_epi64(negativeCounts, popcount256(_mm256_and_si256(values, signs)));
+    }
+
+    count = sum256(counts);
+    negativeCount = sum256(negativeCounts);
+#endif
+
+    for (; w < words; w++) {
+        uint64_t values = pairNonZero[w] & nonZeroK[w];
+        if (!values)
+            continue;
+
+        count += popcount64(values);
+        negativeCount += popcount64(values & (pairNegative[w] ^ negativeK[w]));
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+class BrentValidator {
+    int dimension[3];
+    int elements[3];
+    int rank;
+    int words;
+    int modulo;
+
+    std::vector<uint64_t> nonZero[3];
+    std::vector<uint64_t> negative[3];
+public:
+    BrentValidator(int n1, int n2, int n3, int rank, int modulo);
+
+    void set(int matrix, int index, int element, int value);
+
+    bool validate() const;
+    bool validateParallel() const;
+private:
+    bool validatePair(int i, int j, uint64_t *pairNonZero, uint64_t *pairNegative) const;
+    bool checkSum(int count, int negativeCount, int target) const;
+    void countProducts(const uint64_t *pairNonZero, const uint64_t *pairNegative, int k, int &count, int &negativeCount) const;
+};
@@ -0,0 +1,89 @@
+#include "checkpoint.h"
+
+volatile std::sig_atomic_t stopSignal = 0;
+
+static void onStopSignal(int signal) {
+    stopSignal = signal;
+}
+
+void handleStopSignals() {
+    struct sigaction action = {};
+    action.sa_handler = onStopSignal;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+void CheckpointHeader::write(std::ostream &os) const {
+    writeBinary(os, CHECKPOINT_MAGIC);
+    writeBinary(os, CHECKPOINT_VERSION);
+    writeBinary(os, ring);
+    writeBinary(os, dimension);
+    writeBinary(os, count);
+}
+
+bool CheckpointHeader::read(std::istream &is) {
+    uint32_t magic, version;
+
+    if (!readBinary(is, magic) || magic != CHECKPOINT_MAGIC) {
+        std::cout << "Invalid checkpoint: unknown file format" << std::endl;
+        return false;
+    }
+
+    if (!readBinary(is, version) || version != CHECKPOINT_VERSION) {
+        std::cout << "Invalid checkpoint: unsupported version " << version << " (expected " << CHECKPOINT_VERSION << ")" << std::endl;
+        return false;
+    }
+
+    if (!readBinary(is, ring) || !readBinary(is, dimension) || !readBinary(is, count)) {
+        std::cout << "Invalid checkpoint: truncated header" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckpointHeader::read(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+
+    if (!f) {
+        std::cout << "Unable open file \"" << path << "\"" << std::endl;
+        return false;
+    }
+
+    return read(f);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    wait();
+}
+
+void CheckpointWriter::write(const std::string &path, std::string &&data) {
+    wait();
+    thread = std::thread(save, path, std::move(data));
+}
+
+void CheckpointWriter::wait() {
+    if (thread.joinable())
+        thread.join();
+}
+
+void CheckpointWriter::save(const std::string &path, const std::string &data) {
+    std::string tmpPath = path + ".tmp";
+    std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+    f.write(data.data(), data.size());
+    f.close();
+
+    if (!f) {
+        std::cout << "Unable to write checkpoint to \"" << tmpPath << "\"" << std::endl;
+        return;
+    }
+
+    std::error_code err;
+    std::filesystem::rename(tmpPath, path, err);
+
+    if (err)
+        std::cout << "Unable to rename checkpoint \"" << tmpPath << "\" to \"" << path << "\": " << err.message() << std::endl;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <csignal>
+#include <cstdint>
+#include <filesystem>
+#include "binary_io.hpp"
+
+const uint32_t CHECKPOINT_MAGIC = 0x4B434746; // "FGCK"
+const uint32_t CHECKPOINT_VERSION = 3;
+
+extern volatile std::sig_atomic_t stopSignal;
+
+void handleStopSignals();
+
+struct CheckpointHeader {
+    std::string ring;
+    int dimension[3];
+    int count;
+
+    void write(std::ostream &os) const;
+    bool read(std::istream &is);
+    bool read(const std::string &path);
+};
+
+class CheckpointWriter {
+    std::thread thread;
+public:
+    ~CheckpointWriter();
+
+    void write(const std::string &path, std::string &&data);
+    void wait();
+private:
+    static void save(const std::string &path, const std::string &data);
+};
@@ -0,0 +1,86 @@
+#include "fingerprint_set.h"
+
+FingerprintSet::FingerprintSet(size_t capacity) {
+    size_t size = 16;
+    while (size < capacity)
+        size *= 2;
+
+    slots.assign(size, SchemeFingerprint());
+    count = 0;
+}
+
+size_t FingerprintSet::size() const {
+    return count;
+}
+
+size_t FingerprintSet::capacity() const {
+    return slots.size();
+}
+
+size_t FingerprintSet::memoryUsage() const {
+    return sizeof(FingerprintSet) + slots.capacity() * sizeof(SchemeFingerprint);
+}
+
+bool FingerprintSet::insert(const SchemeFingerprint &fingerprint) {
+    SchemeFingerprint key = normalize(fingerprint);
+    size_t index = find(key);
+
+    if (slots[index] == key)
+        return false;
+
+    if ((count + 1) * 4 > slots.size() * 3) {
+        grow();
+        index = find(key);
+    }
+
+    slots[index] = key;
+    count++;
+    return true;
+}
+
+bool FingerprintSet::contains(const SchemeFingerprint &fingerprint) const {
+    SchemeFingerprint key = normalize(fingerprint);
+    return slots[find(key)] == key;
+}
+
+void FingerprintSet::getValues(std::vector<SchemeFingerprint> &values) const {
+    values.clear();
+    values.reserve(count);
+
+    for (const SchemeFingerprint &slot : slots)
+        if (!slot.empty())
+            values.push_back(slot);
+}
+
+void FingerprintSet::clear() {
+    slots.assign(slots.size(), SchemeFingerprint());
+    count = 0;
+}
+
+size_t FingerprintSet::find(const SchemeFingerprint &fingerprint) const {
+    size_t mask = slots.size() - 1;
+    size_t index = fingerprint.low & mask;
+
+    while (!slots[index].empty() && slots[index] != fingerprint)
+        index = (index + 1) & mask;
+
+    return index;
+}
+
+void FingerprintSet::grow() {
+    std::vector<SchemeFingerprint> old(slots.size() * 2, SchemeFingerprint());
+    std::swap(slots, old);
+
+    for (const SchemeFingerprint &fingerprint : old)
+        if (!fingerprint.empty())
+            slots[find(fingerprint)] = fingerprint;
+}
+
+SchemeFingerprint FingerprintSet::normalize(const SchemeFingerprint &fingerprint) const {
+    if (!fingerprint.empty())
+        return fingerprint;
+
+    SchemeFingerprint key;
+    key.low = 1;
+    return key;
+}
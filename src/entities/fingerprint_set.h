@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "scheme_fingerprint.hpp"
+
+class FingerprintSet {
+    std::vector<SchemeFingerprint> slots;
+    size_t count;
+public:
+    FingerprintSet(size_t capacity = 64);
+
+    size_t size() const;
+    size_t capacity() const;
+    size_t memoryUsage() const;
+
+    bool insert(const SchemeFingerprint &fingerprint);
+    bool contains(const SchemeFingerprint &fingerprint) const;
+    void getValues(std::vector<SchemeFingerprint> &values) const;
+    void clear();
+private:
+    size_t find(const SchemeFingerprint &fingerprint) const;
+    void grow();
+    SchemeFingerprint normalize(const SchemeFingerprint &fingerprint) const;
+};
+
+template <typename Scheme>
+SchemeFingerprint getUniqueFingerprint(const Scheme &scheme, const std::string &uniqueType) {
+    if (uniqueType == "structure")
+        return SchemeFingerprint::fromString(scheme.getStructureHash());
+
+    if (uniqueType == "type")
+        return SchemeFingerprint::fromString(scheme.getTypeInvariant());
+
+    return scheme.getFingerprint();
+}
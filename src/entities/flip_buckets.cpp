@@ -0,0 +1,104 @@
+#include "flip_buckets.h"
+
+FlipBuckets::FlipBuckets() {
+    count = 0;
+}
+
+size_t FlipBuckets::size() const {
+    return count;
+}
+
+void FlipBuckets::reset(size_t capacity) {
+    size_t slots = 16;
+    while (slots < capacity * 2)
+        slots *= 2;
+
+    heads.assign(slots, NONE);
+    keys.clear();
+    next.clear();
+    count = 0;
+}
+
+void FlipBuckets::add(uint64_t key, uint32_t index) {
+    if (heads.empty())
+        reset(index + 1);
+
+    if (index >= keys.size()) {
+        keys.resize(index + 1, 0);
+        next.resize(index + 1, ABSENT);
+    }
+
+    remove(index);
+    count++;
+
+    if (count * 2 > heads.size())
+        rehash(heads.size() * 2);
+
+    keys[index] = uint32_t(key);
+    link(index);
+}
+
+void FlipBuckets::remove(uint32_t index) {
+    if (!contains(index))
+        return;
+
+    unlink(index);
+    next[index] = ABSENT;
+    count--;
+}
+
+void FlipBuckets::move(uint32_t from, uint32_t to) {
+    remove(to);
+
+    if (!contains(from))
+        return;
+
+    uint32_t key = keys[from];
+    remove(from);
+    add(key, to);
+}
+
+void FlipBuckets::collect(uint64_t key, std::vector<uint32_t> &indices) const {
+    indices.clear();
+
+    if (heads.empty())
+        return;
+
+    for (uint32_t index = heads[getSlot(uint32_t(key))]; index != NONE; index = next[index])
+        if (keys[index] == uint32_t(key))
+            indices.push_back(index);
+
+    // chain order depends on the history of updates, sorting keeps walks reproducible after restoring a scheme
+    std::sort(indices.begin(), indices.end());
+}
+
+bool FlipBuckets::contains(uint32_t index) const {
+    return index < next.size() && next[index] != ABSENT;
+}
+
+size_t FlipBuckets::getSlot(uint32_t key) const {
+    return key & (heads.size() - 1);
+}
+
+void FlipBuckets::link(uint32_t index) {
+    size_t slot = getSlot(keys[index]);
+    next[index] = heads[slot];
+    heads[slot] = index;
+}
+
+void FlipBuckets::unlink(uint32_t index) {
+    uint32_t *link = &heads[getSlot(keys[index])];
+
+    while (*link != index)
+        link = &next[*link];
+
+    *link = next[index];
+}
+
+void FlipBuckets::rehash(size_t slots) {
+    heads.assign(slots, NONE);
+
+    for (uint32_t index = 0; index < next.size(); index++)
+        if (next[index] != ABSENT)
+            link(index);
+}
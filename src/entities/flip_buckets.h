@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+class FlipBuckets {
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    static constexpr uint32_t ABSENT = 0xFFFFFFFE;
+
+    std::vector<uint32_t> heads;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> next;
+    size_t count;
+public:
+    FlipBuckets();
+
+    size_t size() const;
+
+    void reset(size_t capacity);
+    void add(uint64_t key, uint32_t index);
+    void remove(uint32_t index);
+    void move(uint32_t from, uint32_t to);
+    void collect(uint64_t key, std::vector<uint32_t> &indices) const;
+private:
+    bool contains(uint32_t index) const;
+    size_t getSlot(uint32_t key) const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+    void rehash(size_t slots);
+};
@@ -5,44 +5,77 @@ size_t FlipSet::size() const {
 }
 
 void FlipSet::add(uint32_t index1, uint32_t index2) {
+    reserveIndex(std::max(index1, index2));
+
+    uint32_t position = pairs.size();
     pairs.push_back((index1 << 16) | index2);
+    next.resize(pairs.size() * 2);
+
+    link(position * 2, index1);
+    link(position * 2 + 1, index2);
+    degrees[index1]++;
+    degrees[index2]++;
 }
 
 void FlipSet::remove(uint32_t index1, uint32_t index2) {
-    uint32_t pair1 = (index1 << 16) | index2;
-    uint32_t pair2 = (index2 << 16) | index1;
-
-    for (size_t i = 0; i < pairs.size(); i++) {
-        if (pairs[i] == pair1 || pairs[i] == pair2) {
-            pairs[i] = pairs.back();
-            pairs.pop_back();
-            return;
-        }
-    }
+    int position = find(index1, index2);
+
+    if (position >= 0)
+        erase(position);
 }
 
 void FlipSet::remove(uint32_t index) {
-    for (size_t i = 0; i < pairs.size(); i++) {
-        if (index1(i) == index || index2(i) == index) {
-            pairs[i--] = pairs.back();
-            pairs.pop_back();
-        }
-    }
+    if (!getDegree(index))
+        return;
+
+    positions.clear();
+
+    for (uint32_t node = heads[index]; node != NONE; node = next[node])
+        positions.push_back(node / 2);
+
+    // erasing in ascending order moves the same pairs as a linear scan would, so the pairs order does not depend on the lists order
+    std::sort(positions.begin(), positions.end());
+
+    for (uint32_t position : positions)
+        while (position < pairs.size() && (index1(position) == index || index2(position) == index))
+            erase(position);
 }
 
-bool FlipSet::contains(uint32_t index1, uint32_t index2) const {
-    uint32_t pair1 = (index1 << 16) | index2;
-    uint32_t pair2 = (index2 << 16) | index1;
+void FlipSet::move(uint32_t from, uint32_t to) {
+    if (!getDegree(from))
+        return;
+
+    reserveIndex(to);
+
+    uint32_t tail = NONE;
+
+    for (uint32_t node = heads[from]; node != NONE; node = next[node]) {
+        uint32_t position = node / 2;
+
+        if (node % 2 == 0)
+            pairs[position] = (to << 16) | index2(position);
+        else
+            pairs[position] = (index1(position) << 16) | to;
+
+        tail = node;
+    }
 
-    for (size_t i = 0; i < pairs.size(); i++)
-        if (pairs[i] == pair1 || pairs[i] == pair2)
-            return true;
+    next[tail] = heads[to];
+    heads[to] = heads[from];
+    heads[from] = NONE;
+    degrees[to] += degrees[from];
+    degrees[from] = 0;
+}
 
-    return false;
+bool FlipSet::contains(uint32_t index1, uint32_t index2) const {
+    return find(index1, index2) >= 0;
 }
 
 void FlipSet::clear() {
     pairs.clear();
+    next.clear();
+    heads.clear();
+    degrees.clear();
 }
 
 uint32_t FlipSet::index1(size_t i) const {
@@ -52,3 +85,107 @@ uint32_t FlipSet::index1(size_t i) const {
 uint32_t FlipSet::index2(size_t i) const {
     return pairs[i] & 0xFFFF;
 }
+
+void FlipSet::pack(std::ostream &os) const {
+    writeBinary(os, pairs);
+    writeBinary(os, degrees);
+}
+
+bool FlipSet::unpack(std::istream &is) {
+    std::vector<uint32_t> packedPairs;
+    std::vector<uint16_t> packedDegrees;
+
+    if (!readBinary(is, packedPairs) || !readBinary(is, packedDegrees))
+        return false;
+
+    clear();
+
+    for (uint32_t pair : packedPairs) {
+        uint32_t pairIndex1 = pair >> 16;
+        uint32_t pairIndex2 = pair & 0xFFFF;
+
+        if (pairIndex1 == pairIndex2 || std::max(pairIndex1, pairIndex2) >= packedDegrees.size())
+            return false;
+
+        add(pairIndex1, pairIndex2);
+    }
+
+    if (!packedDegrees.empty())
+        reserveIndex(packedDegrees.size() - 1);
+
+    return degrees == packedDegrees;
+}
+
+uint16_t FlipSet::getDegree(uint32_t index) const {
+    return index < degrees.size() ? degrees[index] : 0;
+}
+
+uint32_t FlipSet::getIndex(uint32_t node) const {
+    return node % 2 == 0 ? index1(node / 2) : index2(node / 2);
+}
+
+int FlipSet::find(uint32_t index1, uint32_t index2) const {
+    if (!getDegree(index1) || !getDegree(index2))
+        return -1;
+
+    if (degrees[index2] < degrees[index1])
+        std::swap(index1, index2);
+
+    for (uint32_t node = heads[index1]; node != NONE; node = next[node])
+        if (getIndex(node ^ 1) == index2)
+            return node / 2;
+
+    return -1;
+}
+
+void FlipSet::reserveIndex(uint32_t index) {
+    if (index < heads.size())
+        return;
+
+    heads.resize(index + 1, NONE);
+    degrees.resize(index + 1, 0);
+}
+
+uint32_t& FlipSet::getLink(uint32_t node, uint32_t index) {
+    uint32_t *link = &heads[index];
+
+    while (*link != node)
+        link = &next[*link];
+
+    return *link;
+}
+
+void FlipSet::link(uint32_t node, uint32_t index) {
+    next[node] = heads[index];
+    heads[index] = node;
+}
+
+void FlipSet::unlink(uint32_t node, uint32_t index) {
+    getLink(node, index) = next[node];
+}
+
+void FlipSet::relink(uint32_t from, uint32_t to, uint32_t index) {
+    next[to] = next[from];
+    getLink(from, index) = to;
+}
+
+void FlipSet::erase(size_t position) {
+    uint32_t pairIndex1 = index1(position);
+    uint32_t pairIndex2 = index2(position);
+
+    unlink(position * 2, pairIndex1);
+    unlink(position * 2 + 1, pairIndex2);
+    degrees[pairIndex1]--;
+    degrees[pairIndex2]--;
+
+    size_t last = pairs.size() - 1;
+
+    if (position != last) {
+        relink(last * 2, position * 2, index1(last));
+        relink(last * 2 + 1, position * 2 + 1, index2(last));
+        pairs[position] = pairs[last];
+    }
+
+    pairs.pop_back();
+    next.resize(pairs.size() * 2);
+}
@@ -3,18 +3,40 @@
 #include <iostream>
 #include <vector>
 #include <cstdint>
+#include <algorithm>
+#include "binary_io.hpp"
 
 class FlipSet {
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
     std::vector<uint32_t> pairs;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> heads;
+    std::vector<uint16_t> degrees;
+    std::vector<uint32_t> positions;
 public:
     size_t size() const;
 
     void add(uint32_t index1, uint32_t index2);
     void remove(uint32_t index1, uint32_t index2);
     void remove(uint32_t index);
+    void move(uint32_t from, uint32_t to);
     bool contains(uint32_t index1, uint32_t index2) const;
     void clear();
 
     uint32_t index1(size_t i) const;
     uint32_t index2(size_t i) const;
+
+    void pack(std::ostream &os) const;
+    bool unpack(std::istream &is);
+private:
+    uint16_t getDegree(uint32_t index) const;
+    uint32_t getIndex(uint32_t node) const;
+    int find(uint32_t index1, uint32_t index2) const;
+    void reserveIndex(uint32_t index);
+    uint32_t& getLink(uint32_t node, uint32_t index);
+    void link(uint32_t node, uint32_t index);
+    void unlink(uint32_t node, uint32_t index);
+    void relink(uint32_t from, uint32_t to, uint32_t index);
+    void erase(size_t position);
 };
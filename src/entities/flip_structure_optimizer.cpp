@@ -29,7 +29,7 @@ void FlipStructureOptimizer::preprocess() {
     }
 }
 
-std::vector<Flip> FlipStructureOptimizer::selectRandomFlips(const std::vector<Flip> &flips, std::mt19937 &generator) const {
+std::vector<Flip> FlipStructureOptimizer::selectRandomFlips(const std::vector<Flip> &flips, RandomGenerator &generator) const {
     std::vector<Flip> available(flips);
     std::unordered_set<int> ignored[3];
     std::vector<Flip> selected;
@@ -112,7 +112,7 @@ std::vector<int> FlipStructureOptimizer::countSizes(const std::vector<std::unord
     return counts;
 }
 
-std::vector<FlipStructureNode> FlipStructureOptimizer::selectRandomStructure(std::mt19937 &generator) const {
+std::vector<FlipStructureNode> FlipStructureOptimizer::selectRandomStructure(RandomGenerator &generator) const {
     std::vector<Flip> selected = selectRandomFlips(flips, generator);
     std::vector<std::unordered_set<int>> u = groupFlips(selected, 0);
     std::vector<std::unordered_set<int>> v = groupFlips(selected, 1);
@@ -220,7 +220,7 @@ double FlipStructureOptimizer::findOmega(const std::vector<FlipStructureNode> &s
     return x1;
 }
 
-FlipStructure FlipStructureOptimizer::optimize(std::mt19937 &generator, int iterations, double eps) {
+FlipStructure FlipStructureOptimizer::optimize(RandomGenerator &generator, int iterations, double eps) {
     FlipStructure optimized;
     optimized.omega = 3;
     optimized.structure = {};
@@ -313,7 +313,7 @@ std::string FlipStructureOptimizer::getBudsInvariant() const {
     return join(invariant, ", ");
 }
 
-std::unordered_map<std::string, int> FlipStructureOptimizer::getSerendipitousRanks(std::mt19937 &generator, const std::unordered_map<std::string, int> &dimension2rank, int iterations, int maxN) const {
+std::unordered_map<std::string, int> FlipStructureOptimizer::getSerendipitousRanks(RandomGenerator &generator, const std::unordered_map<std::string, int> &dimension2rank, int iterations, int maxN) const {
     std::unordered_map<std::string, int> dimension2serendipitousRank;
 
     for (int n1 = 1; n1 <= maxN; n1++)
@@ -372,7 +372,7 @@ std::unordered_map<std::string, int> FlipStructureOptimizer::getSerendipitousRan
     return dimension2serendipitousRank;
 }
 
-std::vector<std::vector<std::unordered_set<int>>> FlipStructureOptimizer::getGroups(std::mt19937 &generator) const {
+std::vector<std::vector<std::unordered_set<int>>> FlipStructureOptimizer::getGroups(RandomGenerator &generator) const {
     std::vector<Flip> selected = selectRandomFlips(dependentFlips, generator);
     for (const Flip &flip : independentFlips)
         selected.push_back(flip);
@@ -35,10 +35,10 @@ class FlipStructureOptimizer {
     std::vector<Flip> independentFlips;
     std::vector<Flip> dependentFlips;
 
-    std::vector<Flip> selectRandomFlips(const std::vector<Flip> &flips, std::mt19937 &generator) const;
+    std::vector<Flip> selectRandomFlips(const std::vector<Flip> &flips, RandomGenerator &generator) const;
     std::vector<std::unordered_set<int>> groupFlips(const std::vector<Flip> &flips, int p) const;
     std::vector<int> countSizes(const std::vector<std::unordered_set<int>> &components) const;
-    std::vector<FlipStructureNode> selectRandomStructure(std::mt19937 &generator) const;
+    std::vector<FlipStructureNode> selectRandomStructure(RandomGenerator &generator) const;
 
     double f(double omega, const std::vector<FlipStructureNode> &structure) const;
     double df(double omega, const std::vector<FlipStructureNode> &structure) const;
@@ -50,11 +50,11 @@ public:
     void add(int p, int i, int j);
     void preprocess();
 
-    FlipStructure optimize(std::mt19937 &generator, int iterations, double eps);
+    FlipStructure optimize(RandomGenerator &generator, int iterations, double eps);
     std::vector<Flip> getFlips() const;
     std::string getBudsInvariant() const;
-    std::unordered_map<std::string, int> getSerendipitousRanks(std::mt19937 &generator, const std::unordered_map<std::string, int> &dimension2rank, int iterations, int maxN = 16) const;
-    std::vector<std::vector<std::unordered_set<int>>> getGroups(std::mt19937 &generator) const;
+    std::unordered_map<std::string, int> getSerendipitousRanks(RandomGenerator &generator, const std::unordered_map<std::string, int> &dimension2rank, int iterations, int maxN = 16) const;
+    std::vector<std::vector<std::unordered_set<int>>> getGroups(RandomGenerator &generator) const;
 };
 
 std::ostream& operator<<(std::ostream &os, const FlipStructure &structure);
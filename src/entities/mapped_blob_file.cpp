@@ -0,0 +1,131 @@
+#include "mapped_blob_file.h"
+
+MappedBlobFile::MappedBlobFile(const std::string &directory) {
+    this->directory = directory;
+    this->fd = -1;
+    this->data = nullptr;
+    this->mapped = 0;
+    this->recordSize = 0;
+    this->count = 0;
+}
+
+MappedBlobFile::MappedBlobFile(MappedBlobFile &&file) noexcept : MappedBlobFile(file.directory) {
+    *this = std::move(file);
+}
+
+MappedBlobFile& MappedBlobFile::operator=(MappedBlobFile &&file) noexcept {
+    if (this == &file)
+        return *this;
+
+    close();
+    directory = std::move(file.directory);
+    fd = file.fd;
+    data = file.data;
+    mapped = file.mapped;
+    recordSize = file.recordSize;
+    count = file.count;
+
+    file.fd = -1;
+    file.data = nullptr;
+    file.mapped = 0;
+    file.recordSize = 0;
+    file.count = 0;
+    return *this;
+}
+
+MappedBlobFile::~MappedBlobFile() {
+    close();
+}
+
+size_t MappedBlobFile::size() const {
+    return count;
+}
+
+size_t MappedBlobFile::fileSize() const {
+    return count * recordSize;
+}
+
+size_t MappedBlobFile::getRecordSize() const {
+    return recordSize;
+}
+
+void MappedBlobFile::push(const std::vector<uint8_t> &blob) {
+    if (recordSize == 0)
+        recordSize = blob.size();
+    else if (blob.size() != recordSize)
+        throw std::runtime_error("MappedBlobFile: record size mismatch (" + std::to_string(blob.size()) + " != " + std::to_string(recordSize) + ")");
+
+    reserve((count + 1) * recordSize);
+    memcpy(data + count * recordSize, blob.data(), recordSize);
+    count++;
+}
+
+void MappedBlobFile::set(size_t index, const std::vector<uint8_t> &blob) {
+    if (blob.size() != recordSize)
+        throw std::runtime_error("MappedBlobFile: record size mismatch (" + std::to_string(blob.size()) + " != " + std::to_string(recordSize) + ")");
+
+    memcpy(data + index * recordSize, blob.data(), recordSize);
+}
+
+const uint8_t* MappedBlobFile::get(size_t index) const {
+    return data + index * recordSize;
+}
+
+void MappedBlobFile::clear() {
+    close();
+    recordSize = 0;
+    count = 0;
+}
+
+void MappedBlobFile::open() {
+    std::string path = directory + "/pool_XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+
+    fd = mkstemp(name.data());
+    if (fd < 0)
+        throw std::runtime_error("MappedBlobFile: unable to create file in \"" + directory + "\": " + strerror(errno));
+
+    unlink(name.data());
+}
+
+void MappedBlobFile::close() {
+    if (data)
+        munmap(data, mapped);
+
+    if (fd >= 0)
+        ::close(fd);
+
+    fd = -1;
+    data = nullptr;
+    mapped = 0;
+}
+
+void MappedBlobFile::reserve(size_t bytes) {
+    if (bytes <= mapped)
+        return;
+
+    if (fd < 0)
+        open();
+
+    size_t capacity = std::max(MAPPED_BLOB_FILE_MIN_SIZE, mapped);
+    while (capacity < bytes)
+        capacity *= 2;
+
+    if (ftruncate(fd, capacity) != 0)
+        throw std::runtime_error("MappedBlobFile: unable to grow file to " + std::to_string(capacity) + " bytes: " + strerror(errno));
+
+    if (data)
+        munmap(data, mapped);
+
+    data = nullptr;
+    mapped = 0;
+
+    void *region = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED)
+        throw std::runtime_error("MappedBlobFile: unable to map " + std::to_string(capacity) + " bytes: " + strerror(errno));
+
+    madvise(region, capacity, MADV_RANDOM);
+    data = static_cast<uint8_t *>(region);
+    mapped = capacity;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+const size_t MAPPED_BLOB_FILE_MIN_SIZE = 1 << 20;
+
+class MappedBlobFile {
+    std::string directory;
+    int fd;
+    uint8_t *data;
+    size_t mapped;
+    size_t recordSize;
+    size_t count;
+public:
+    MappedBlobFile(const std::string &directory = "");
+    MappedBlobFile(MappedBlobFile &&file) noexcept;
+    MappedBlobFile& operator=(MappedBlobFile &&file) noexcept;
+    MappedBlobFile(const MappedBlobFile &file) = delete;
+    MappedBlobFile& operator=(const MappedBlobFile &file) = delete;
+    ~MappedBlobFile();
+
+    size_t size() const;
+    size_t fileSize() const;
+    size_t getRecordSize() const;
+
+    void push(const std::vector<uint8_t> &blob);
+    void set(size_t index, const std::vector<uint8_t> &blob);
+    const uint8_t* get(size_t index) const;
+    void clear();
+private:
+    void open();
+    void close();
+    void reserve(size_t bytes);
+};
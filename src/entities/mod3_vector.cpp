@@ -1,5 +1,5 @@
 #include "mod3_vector.hpp"
-#include "uint256_t.h"
+#include "bit_vector.hpp"
 
 template <typename T>
 int Mod3Vector<T>::nonZeroCount() const {
@@ -18,8 +18,22 @@ int Mod3Vector<uint256_t>::nonZeroCount() const {
     return values.popcount();
 }
 
+template <>
+int Mod3Vector<uint512_t>::nonZeroCount() const {
+    uint512_t values = low | high;
+    return values.popcount();
+}
+
+template <>
+int Mod3Vector<uint1024_t>::nonZeroCount() const {
+    uint1024_t values = low | high;
+    return values.popcount();
+}
+
 template class Mod3Vector<uint16_t>;
 template class Mod3Vector<uint32_t>;
 template class Mod3Vector<uint64_t>;
 template class Mod3Vector<__uint128_t>;
 template class Mod3Vector<uint256_t>;
+template class Mod3Vector<uint512_t>;
+template class Mod3Vector<uint1024_t>;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "uint256_t.h"
+#include "bit_vector.hpp"
 
 template <typename T>
 struct Mod3Vector {
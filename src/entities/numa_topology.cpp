@@ -0,0 +1,180 @@
+#include "numa_topology.h"
+
+NumaTopology::NumaTopology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool hasAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    std::error_code err;
+
+    for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", err)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+            continue;
+
+        std::ifstream f(entry.path() / "cpulist");
+        std::string list;
+        if (!std::getline(f, list))
+            continue;
+
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(list))
+            if (!hasAffinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)))
+                cpus.push_back(cpu);
+
+        if (!cpus.empty())
+            nodes.emplace_back(std::stoi(name.substr(4)), cpus);
+    }
+
+    if (nodes.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE && hasAffinity; cpu++)
+            if (CPU_ISSET(cpu, &allowed))
+                cpus.push_back(cpu);
+
+        nodes.emplace_back(0, cpus);
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+
+    for (const auto &node : nodes) {
+        nodeIds.push_back(node.first);
+        nodeCpus.push_back(node.second);
+    }
+
+    partition(1, 1);
+}
+
+void NumaTopology::partition(int threads, int count) {
+    std::vector<int> cpuWeights;
+    for (const auto &cpus : nodeCpus)
+        cpuWeights.push_back(std::max(int(cpus.size()), 1));
+
+    threadOffsets = split(threads, cpuWeights);
+
+    std::vector<int> threadWeights;
+    for (size_t node = 0; node < nodeCpus.size(); node++)
+        threadWeights.push_back(threadOffsets[node + 1] - threadOffsets[node]);
+
+    runnerOffsets = split(count, threadWeights);
+}
+
+int NumaTopology::getNodesCount() const {
+    return nodeCpus.size();
+}
+
+int NumaTopology::getNodeId(int node) const {
+    return nodeIds[node];
+}
+
+int NumaTopology::getNode(int thread) const {
+    int node = 0;
+    while (node + 1 < getNodesCount() && thread >= threadOffsets[node + 1])
+        node++;
+
+    return node;
+}
+
+int NumaTopology::getRunnersBegin(int node) const {
+    return runnerOffsets[node];
+}
+
+int NumaTopology::getRunnersEnd(int node) const {
+    return runnerOffsets[node + 1];
+}
+
+bool NumaTopology::pinThread(int thread) const {
+    int node = getNode(thread);
+    const std::vector<int> &cpus = nodeCpus[node];
+    if (cpus.empty())
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[(thread - threadOffsets[node]) % cpus.size()], &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+void NumaTopology::resetRunners() {
+    nextRunners.assign(runnerOffsets.begin(), runnerOffsets.end() - 1);
+}
+
+int NumaTopology::nextRunner(int node) {
+    int runner;
+
+    #pragma omp atomic capture
+    runner = nextRunners[node]++;
+
+    return runner < runnerOffsets[node + 1] ? runner : -1;
+}
+
+std::ostream& operator<<(std::ostream &os, const NumaTopology &topology) {
+    os << "NUMA topology: " << topology.getNodesCount() << " node" << (topology.getNodesCount() > 1 ? "s" : "") << std::endl;
+
+    for (int node = 0; node < topology.getNodesCount(); node++) {
+        os << "- node " << topology.nodeIds[node] << ": ";
+        os << "cpus " << NumaTopology::formatCpuList(topology.nodeCpus[node]) << ", ";
+        os << "threads " << (topology.threadOffsets[node + 1] - topology.threadOffsets[node]) << ", ";
+        os << "runners " << (topology.runnerOffsets[node + 1] - topology.runnerOffsets[node]) << std::endl;
+    }
+
+    return os;
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string &list) {
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || !isdigit(range[0]))
+            continue;
+
+        size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+        for (int cpu = first; cpu <= last; cpu++)
+            cpus.push_back(cpu);
+    }
+
+    return cpus;
+}
+
+std::vector<int> NumaTopology::split(int items, const std::vector<int> &weights) {
+    long total = 0;
+    for (int weight : weights)
+        total += weight;
+
+    std::vector<int> offsets(weights.size() + 1, 0);
+    long prefix = 0;
+
+    for (size_t i = 0; i < weights.size(); i++) {
+        prefix += weights[i];
+        offsets[i + 1] = total ? int(prefix * items / total) : items;
+    }
+
+    return offsets;
+}
+
+std::string NumaTopology::formatCpuList(const std::vector<int> &cpus) {
+    std::stringstream ss;
+
+    for (size_t i = 0; i < cpus.size(); i++) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1)
+            j++;
+
+        if (i > 0)
+            ss << ",";
+
+        ss << cpus[i];
+        if (j > i)
+            ss << "-" << cpus[j];
+
+        i = j;
+    }
+
+    return ss.str();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <sched.h>
+
+class NumaTopology {
+    std::vector<int> nodeIds;
+    std::vector<std::vector<int>> nodeCpus;
+    std::vector<int> threadOffsets;
+    std::vector<int> runnerOffsets;
+    std::vector<int> nextRunners;
+public:
+    NumaTopology();
+
+    void partition(int threads, int count);
+
+    int getNodesCount() const;
+    int getNodeId(int node) const;
+    int getNode(int thread) const;
+    int getRunnersBegin(int node) const;
+    int getRunnersEnd(int node) const;
+    bool pinThread(int thread) const;
+
+    void resetRunners();
+    int nextRunner(int node);
+
+    friend std::ostream& operator<<(std::ostream &os, const NumaTopology &topology);
+private:
+    static std::vector<int> parseCpuList(const std::string &list);
+    static std::vector<int> split(int items, const std::vector<int> &weights);
+    static std::string formatCpuList(const std::vector<int> &cpus);
+};
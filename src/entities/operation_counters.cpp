@@ -0,0 +1,85 @@
+#include "operation_counters.h"
+#include "../utils.h"
+
+OperationCounters::OperationCounters() {
+    flips = 0;
+    failedFlips = 0;
+    flipCandidates = 0;
+    rejectedFlips = 0;
+    flipReductions = 0;
+    plus = 0;
+    failedPlus = 0;
+    splits = 0;
+    failedSplits = 0;
+    failedExpands = 0;
+    reductions = 0;
+    sandwichings = 0;
+    rejectedSandwichings = 0;
+}
+
+size_t OperationCounters::getOperations() const {
+    return flips + failedFlips + plus + failedPlus + splits + failedSplits + failedExpands + reductions + sandwichings + rejectedSandwichings;
+}
+
+OperationCounters& OperationCounters::operator+=(const OperationCounters &counters) {
+    flips += counters.flips;
+    failedFlips += counters.failedFlips;
+    flipCandidates += counters.flipCandidates;
+    rejectedFlips += counters.rejectedFlips;
+    flipReductions += counters.flipReductions;
+    plus += counters.plus;
+    failedPlus += counters.failedPlus;
+    splits += counters.splits;
+    failedSplits += counters.failedSplits;
+    failedExpands += counters.failedExpands;
+    reductions += counters.reductions;
+    sandwichings += counters.sandwichings;
+    rejectedSandwichings += counters.rejectedSandwichings;
+    return *this;
+}
+
+OperationCounters OperationCounters::operator-(const OperationCounters &counters) const {
+    OperationCounters result;
+    result.flips = flips - counters.flips;
+    result.failedFlips = failedFlips - counters.failedFlips;
+    result.flipCandidates = flipCandidates - counters.flipCandidates;
+    result.rejectedFlips = rejectedFlips - counters.rejectedFlips;
+    result.flipReductions = flipReductions - counters.flipReductions;
+    result.plus = plus - counters.plus;
+    result.failedPlus = failedPlus - counters.failedPlus;
+    result.splits = splits - counters.splits;
+    result.failedSplits = failedSplits - counters.failedSplits;
+    result.failedExpands = failedExpands - counters.failedExpands;
+    result.reductions = reductions - counters.reductions;
+    result.sandwichings = sandwichings - counters.sandwichings;
+    result.rejectedSandwichings = rejectedSandwichings - counters.rejectedSandwichings;
+    return result;
+}
+
+void OperationCounters::print(std::ostream &os, double elapsed) const {
+    size_t flipsPerSecond = elapsed > 0 ? size_t(flips / elapsed) : 0;
+    size_t operationsPerSecond = elapsed > 0 ? size_t(getOperations() / elapsed) : 0;
+
+    os << "- flips: " << prettyInt(flips) << " (" << prettyInt(flipsPerSecond) << "/s), failed: " << prettyInt(failedFlips) << ", rejected candidates: " << prettyInt(rejectedFlips) << " / " << prettyInt(flipCandidates) << ", reductions: " << prettyInt(flipReductions) << std::endl;
+    os << "- plus: " << prettyInt(plus) << " (failed: " << prettyInt(failedPlus) << "), split: " << prettyInt(splits) << " (failed: " << prettyInt(failedSplits) << "), failed expands: " << prettyInt(failedExpands) << std::endl;
+    os << "- reductions: " << prettyInt(reductions) << ", sandwichings: " << prettyInt(sandwichings) << " (rejected: " << prettyInt(rejectedSandwichings) << ")" << std::endl;
+    os << "- operations: " << prettyInt(getOperations()) << " (" << prettyInt(operationsPerSecond) << "/s)" << std::endl;
+}
+
+void OperationCounters::writeJSON(std::ostream &os) const {
+    os << "{";
+    os << "\"flips\": " << flips << ", ";
+    os << "\"failed_flips\": " << failedFlips << ", ";
+    os << "\"flip_candidates\": " << flipCandidates << ", ";
+    os << "\"rejected_flips\": " << rejectedFlips << ", ";
+    os << "\"flip_reductions\": " << flipReductions << ", ";
+    os << "\"plus\": " << plus << ", ";
+    os << "\"failed_plus\": " << failedPlus << ", ";
+    os << "\"splits\": " << splits << ", ";
+    os << "\"failed_splits\": " << failedSplits << ", ";
+    os << "\"failed_expands\": " << failedExpands << ", ";
+    os << "\"reductions\": " << reductions << ", ";
+    os << "\"sandwichings\": " << sandwichings << ", ";
+    os << "\"rejected_sandwichings\": " << rejectedSandwichings;
+    os << "}";
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <iostream>
+#include <cstddef>
+
+struct OperationCounters {
+    size_t flips;
+    size_t failedFlips;
+    size_t flipCandidates;
+    size_t rejectedFlips;
+    size_t flipReductions;
+    size_t plus;
+    size_t failedPlus;
+    size_t splits;
+    size_t failedSplits;
+    size_t failedExpands;
+    size_t reductions;
+    size_t sandwichings;
+    size_t rejectedSandwichings;
+
+    OperationCounters();
+
+    size_t getOperations() const;
+
+    OperationCounters& operator+=(const OperationCounters &counters);
+    OperationCounters operator-(const OperationCounters &counters) const;
+
+    void print(std::ostream &os, double elapsed) const;
+    void writeJSON(std::ostream &os) const;
+};
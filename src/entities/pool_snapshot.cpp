@@ -0,0 +1,185 @@
+#include "pool_snapshot.h"
+
+// dimension length, rank, count, record size, fingerprints, index, complexity and flips ranges, offset
+static const uint64_t POOL_SNAPSHOT_SECTION_MIN_SIZE = sizeof(uint64_t) * 6 + sizeof(int) * 5;
+
+template <typename T>
+static bool readField(const uint8_t *&data, const uint8_t *end, T &value) {
+    if (size_t(end - data) < sizeof(T))
+        return false;
+
+    readBlob(data, value);
+    return true;
+}
+
+static bool readField(const uint8_t *&data, const uint8_t *end, std::string &value) {
+    uint64_t length;
+    if (!readField(data, end, length) || uint64_t(end - data) < length)
+        return false;
+
+    value.assign(reinterpret_cast<const char *>(data), length);
+    data += length;
+    return true;
+}
+
+uint64_t PoolSnapshotSection::getDataSize() const {
+    return count * (recordSize + sizeof(int32_t)) + fingerprints * 2 * sizeof(uint64_t);
+}
+
+void PoolSnapshotSection::write(std::ostream &os) const {
+    writeBinary(os, dimension);
+    writeBinary(os, rank);
+    writeBinary(os, count);
+    writeBinary(os, recordSize);
+    writeBinary(os, fingerprints);
+    writeBinary(os, index);
+    writeBinary(os, minComplexity);
+    writeBinary(os, maxComplexity);
+    writeBinary(os, minFlips);
+    writeBinary(os, maxFlips);
+    writeBinary(os, offset);
+}
+
+void PoolSnapshotHeader::write(std::ostream &os, std::vector<PoolSnapshotSection> &sections) const {
+    uint64_t offset = 0;
+
+    for (PoolSnapshotSection &section : sections) {
+        section.offset = offset;
+        offset += section.getDataSize();
+    }
+
+    writeBinary(os, POOL_SNAPSHOT_MAGIC);
+    writeBinary(os, POOL_SNAPSHOT_VERSION);
+    writeBinary(os, ring);
+    writeBinary(os, uniqueType);
+    writeBinary(os, watermark);
+    writeBinary(os, uint64_t(sections.size()));
+
+    for (const PoolSnapshotSection &section : sections)
+        section.write(os);
+}
+
+PoolSnapshot::PoolSnapshot() {
+    fd = -1;
+    data = nullptr;
+    size = 0;
+    payload = nullptr;
+}
+
+PoolSnapshot::~PoolSnapshot() {
+    close();
+}
+
+bool PoolSnapshot::open(const std::string &path) {
+    close();
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Unable to open pool snapshot \"" << path << "\": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cout << "Invalid pool snapshot: empty file" << std::endl;
+        close();
+        return false;
+    }
+
+    size = info.st_size;
+    void *region = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (region == MAP_FAILED) {
+        std::cout << "Unable to map pool snapshot \"" << path << "\": " << strerror(errno) << std::endl;
+        close();
+        return false;
+    }
+
+    data = static_cast<uint8_t *>(region);
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    if (!parse()) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+const PoolSnapshotHeader& PoolSnapshot::getHeader() const {
+    return header;
+}
+
+const std::vector<PoolSnapshotSection>& PoolSnapshot::getSections() const {
+    return sections;
+}
+
+const uint8_t* PoolSnapshot::getData(const PoolSnapshotSection &section) const {
+    return payload + section.offset;
+}
+
+void PoolSnapshot::close() {
+    if (data)
+        munmap(data, size);
+
+    if (fd >= 0)
+        ::close(fd);
+
+    fd = -1;
+    data = nullptr;
+    size = 0;
+    payload = nullptr;
+    sections.clear();
+}
+
+bool PoolSnapshot::parse() {
+    const uint8_t *it = data;
+    const uint8_t *end = data + size;
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t count = 0;
+
+    if (!readField(it, end, magic) || magic != POOL_SNAPSHOT_MAGIC) {
+        std::cout << "Invalid pool snapshot: unknown file format" << std::endl;
+        return false;
+    }
+
+    if (!readField(it, end, version) || version != POOL_SNAPSHOT_VERSION) {
+        std::cout << "Invalid pool snapshot: unsupported version " << version << " (expected " << POOL_SNAPSHOT_VERSION << ")" << std::endl;
+        return false;
+    }
+
+    if (!readField(it, end, header.ring) || !readField(it, end, header.uniqueType) || !readField(it, end, header.watermark) || !readField(it, end, count)) {
+        std::cout << "Invalid pool snapshot: truncated header" << std::endl;
+        return false;
+    }
+
+    if (count > uint64_t(end - it) / POOL_SNAPSHOT_SECTION_MIN_SIZE) {
+        std::cout << "Invalid pool snapshot: truncated index" << std::endl;
+        return false;
+    }
+
+    sections.resize(count);
+
+    for (PoolSnapshotSection &section : sections) {
+        bool valid = readField(it, end, section.dimension) && readField(it, end, section.rank) && readField(it, end, section.count);
+        valid = valid && readField(it, end, section.recordSize) && readField(it, end, section.fingerprints) && readField(it, end, section.index);
+        valid = valid && readField(it, end, section.minComplexity) && readField(it, end, section.maxComplexity);
+        valid = valid && readField(it, end, section.minFlips) && readField(it, end, section.maxFlips) && readField(it, end, section.offset);
+
+        if (!valid) {
+            std::cout << "Invalid pool snapshot: truncated index" << std::endl;
+            return false;
+        }
+    }
+
+    payload = it;
+
+    for (const PoolSnapshotSection &section : sections) {
+        if (section.offset + section.getDataSize() > uint64_t(end - payload)) {
+            std::cout << "Invalid pool snapshot: truncated data of " << section.dimension << " rank " << section.rank << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
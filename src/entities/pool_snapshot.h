@@ -0,0 +1,64 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "binary_io.hpp"
+
+const uint32_t POOL_SNAPSHOT_MAGIC = 0x53504746; // "FGPS"
+const uint32_t POOL_SNAPSHOT_VERSION = 3;
+
+struct PoolSnapshotSection {
+    std::string dimension;
+    int rank;
+    uint64_t count;
+    uint64_t recordSize;
+    uint64_t fingerprints;
+    uint64_t index;
+    int minComplexity;
+    int maxComplexity;
+    int minFlips;
+    int maxFlips;
+    uint64_t offset;
+
+    uint64_t getDataSize() const;
+    void write(std::ostream &os) const;
+};
+
+struct PoolSnapshotHeader {
+    std::string ring;
+    std::string uniqueType;
+    int64_t watermark; // scheme files modified since this file time are not in the snapshot
+
+    void write(std::ostream &os, std::vector<PoolSnapshotSection> &sections) const;
+};
+
+class PoolSnapshot {
+    int fd;
+    uint8_t *data;
+    size_t size;
+    const uint8_t *payload;
+    PoolSnapshotHeader header;
+    std::vector<PoolSnapshotSection> sections;
+public:
+    PoolSnapshot();
+    ~PoolSnapshot();
+
+    bool open(const std::string &path);
+
+    const PoolSnapshotHeader& getHeader() const;
+    const std::vector<PoolSnapshotSection>& getSections() const;
+    const uint8_t* getData(const PoolSnapshotSection &section) const;
+private:
+    void close();
+    bool parse();
+};
@@ -0,0 +1,113 @@
+#include "random_generator.h"
+
+RandomGenerator::RandomGenerator(uint32_t seed, const std::string &type) {
+    this->type = parseType(type);
+    this->position = BLOCK_SIZE;
+
+    // mt19937 keeps about 5KB of state, so it is allocated only when selected
+    if (this->type == RandomGeneratorType::MT19937)
+        mt = std::make_unique<std::mt19937>(seed);
+
+    std::seed_seq seq{seed};
+    seedXoshiro(seq);
+}
+
+RandomGenerator::RandomGenerator(std::seed_seq &seq, const std::string &type) {
+    this->type = parseType(type);
+    this->position = BLOCK_SIZE;
+
+    if (this->type == RandomGeneratorType::MT19937)
+        mt = std::make_unique<std::mt19937>(seq);
+
+    seedXoshiro(seq);
+}
+
+RandomGenerator::RandomGenerator(const RandomGenerator &generator) {
+    *this = generator;
+}
+
+RandomGenerator& RandomGenerator::operator=(const RandomGenerator &generator) {
+    if (this == &generator)
+        return *this;
+
+    type = generator.type;
+    std::copy(std::begin(generator.state), std::end(generator.state), std::begin(state));
+    mt = generator.mt ? std::make_unique<std::mt19937>(*generator.mt) : nullptr;
+    std::copy(std::begin(generator.block), std::end(generator.block), std::begin(block));
+    position = generator.position;
+    return *this;
+}
+
+std::string RandomGenerator::getType() const {
+    return type == RandomGeneratorType::Xoshiro ? "xoshiro" : "mt19937";
+}
+
+void RandomGenerator::pack(std::ostream &os) const {
+    std::stringstream ss;
+    if (mt)
+        ss << *mt;
+
+    writeBinary(os, uint8_t(type));
+    writeBinary(os, state);
+    writeBinary(os, ss.str());
+    writeBinary(os, block);
+    writeBinary(os, position);
+}
+
+bool RandomGenerator::unpack(std::istream &is) {
+    uint8_t packedType;
+    std::string mtState;
+
+    if (!readBinary(is, packedType) || !readBinary(is, state) || !readBinary(is, mtState) || !readBinary(is, block) || !readBinary(is, position))
+        return false;
+
+    if (packedType > uint8_t(RandomGeneratorType::MT19937) || position < 0 || position > BLOCK_SIZE)
+        return false;
+
+    type = RandomGeneratorType(packedType);
+
+    if (type == RandomGeneratorType::Xoshiro) {
+        mt.reset();
+        return true;
+    }
+
+    mt = std::make_unique<std::mt19937>();
+
+    std::stringstream ss(mtState);
+    ss >> *mt;
+    return bool(ss);
+}
+
+void RandomGenerator::seedXoshiro(std::seed_seq &seq) {
+    uint32_t seedData[8];
+    seq.generate(std::begin(seedData), std::end(seedData));
+
+    for (int i = 0; i < 4; i++)
+        state[i] = (uint64_t(seedData[2 * i]) << 32) | seedData[2 * i + 1];
+
+    if (!state[0] && !state[1] && !state[2] && !state[3])
+        state[0] = 0x9E3779B97F4A7C15ULL;
+}
+
+void RandomGenerator::refill() {
+    if (type == RandomGeneratorType::Xoshiro) {
+        for (int i = 0; i < BLOCK_SIZE; i++)
+            block[i] = uint32_t(next() >> 32);
+    }
+    else {
+        for (int i = 0; i < BLOCK_SIZE; i++)
+            block[i] = (*mt)();
+    }
+
+    position = 0;
+}
+
+RandomGeneratorType RandomGenerator::parseType(const std::string &type) {
+    if (type == "mt19937")
+        return RandomGeneratorType::MT19937;
+
+    if (type != "xoshiro")
+        std::cerr << "Unknown random generator type \"" << type << "\", xoshiro is used" << std::endl;
+
+    return RandomGeneratorType::Xoshiro;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <iostream>
+#include <random>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <cstdint>
+#include "binary_io.hpp"
+
+enum class RandomGeneratorType {
+    Xoshiro,
+    MT19937
+};
+
+class alignas(64) RandomGenerator {
+    static constexpr int BLOCK_SIZE = 64;
+
+    RandomGeneratorType type;
+    uint64_t state[4];
+    std::unique_ptr<std::mt19937> mt;
+    uint32_t block[BLOCK_SIZE];
+    int position;
+public:
+    typedef uint32_t result_type;
+
+    RandomGenerator(uint32_t seed, const std::string &type);
+    RandomGenerator(std::seed_seq &seq, const std::string &type);
+    RandomGenerator(const RandomGenerator &generator);
+    RandomGenerator(RandomGenerator &&generator) = default;
+
+    RandomGenerator& operator=(const RandomGenerator &generator);
+    RandomGenerator& operator=(RandomGenerator &&generator) = default;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    // the engine is selected once per block, so draws do not branch on the generator type
+    result_type operator()() {
+        if (position == BLOCK_SIZE)
+            refill();
+
+        return block[position++];
+    }
+
+    std::string getType() const;
+
+    void pack(std::ostream &os) const;
+    bool unpack(std::istream &is);
+private:
+    void seedXoshiro(std::seed_seq &seq);
+    void refill();
+
+    uint64_t next() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+    static uint64_t rotate(uint64_t value, int k) {
+        return (value << k) | (value >> (64 - k));
+    }
+
+    static RandomGeneratorType parseType(const std::string &type);
+};
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "binary_io.hpp"
+
+// rows of the three factors in one block, term-major (u, v, w of a term are adjacent), so a whole scheme is copied with a single bulk copy
+template <typename Row>
+class SchemeArena {
+    static_assert(std::is_trivially_copyable<Row>::value, "SchemeArena requires trivially copyable rows");
+
+    std::vector<Row> rows;
+    int sizes[3];
+public:
+    class Factor {
+        SchemeArena *arena;
+        int matrix;
+    public:
+        Factor(SchemeArena *arena, int matrix);
+
+        Row& operator[](int index) const;
+        Row& back() const;
+        int size() const;
+        int capacity() const;
+
+        void push_back(const Row &row) const;
+        void emplace_back(const Row &row) const;
+        void pop_back() const;
+        void clear() const;
+        void reserve(int capacity) const;
+        void resize(int size) const;
+        void assign(int size, const Row &row) const;
+    };
+
+    class ConstFactor {
+        const SchemeArena *arena;
+        int matrix;
+    public:
+        ConstFactor(const SchemeArena *arena, int matrix);
+
+        const Row& operator[](int index) const;
+        const Row& back() const;
+        int size() const;
+        int capacity() const;
+    };
+
+    SchemeArena();
+
+    Factor operator[](int matrix);
+    ConstFactor operator[](int matrix) const;
+
+    int capacity() const;
+    void reserve(int capacity);
+    void copy(const SchemeArena &arena);
+
+    void pack(std::ostream &os, int matrix) const;
+    bool unpack(std::istream &is, int matrix, int size);
+private:
+    int getTerms() const;
+};
+
+template <typename Row>
+SchemeArena<Row>::Factor::Factor(SchemeArena *arena, int matrix) : arena(arena), matrix(matrix) {
+
+}
+
+template <typename Row>
+Row& SchemeArena<Row>::Factor::operator[](int index) const {
+    return arena->rows[index * 3 + matrix];
+}
+
+template <typename Row>
+Row& SchemeArena<Row>::Factor::back() const {
+    return arena->rows[(arena->sizes[matrix] - 1) * 3 + matrix];
+}
+
+template <typename Row>
+int SchemeArena<Row>::Factor::size() const {
+    return arena->sizes[matrix];
+}
+
+template <typename Row>
+int SchemeArena<Row>::Factor::capacity() const {
+    return arena->capacity();
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::push_back(const Row &row) const {
+    int size = arena->sizes[matrix];
+
+    if (size == arena->capacity())
+        arena->reserve(std::max(16, size * 2));
+
+    arena->rows[size * 3 + matrix] = row;
+    arena->sizes[matrix]++;
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::emplace_back(const Row &row) const {
+    push_back(row);
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::pop_back() const {
+    arena->sizes[matrix]--;
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::clear() const {
+    arena->sizes[matrix] = 0;
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::reserve(int capacity) const {
+    arena->reserve(capacity);
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::resize(int size) const {
+    assign(size, Row());
+}
+
+template <typename Row>
+void SchemeArena<Row>::Factor::assign(int size, const Row &row) const {
+    arena->reserve(size);
+
+    for (int index = 0; index < size; index++)
+        arena->rows[index * 3 + matrix] = row;
+
+    arena->sizes[matrix] = size;
+}
+
+template <typename Row>
+SchemeArena<Row>::ConstFactor::ConstFactor(const SchemeArena *arena, int matrix) : arena(arena), matrix(matrix) {
+
+}
+
+template <typename Row>
+const Row& SchemeArena<Row>::ConstFactor::operator[](int index) const {
+    return arena->rows[index * 3 + matrix];
+}
+
+template <typename Row>
+const Row& SchemeArena<Row>::ConstFactor::back() const {
+    return arena->rows[(arena->sizes[matrix] - 1) * 3 + matrix];
+}
+
+template <typename Row>
+int SchemeArena<Row>::ConstFactor::size() const {
+    return arena->sizes[matrix];
+}
+
+template <typename Row>
+int SchemeArena<Row>::ConstFactor::capacity() const {
+    return arena->capacity();
+}
+
+template <typename Row>
+SchemeArena<Row>::SchemeArena() {
+    for (int i = 0; i < 3; i++)
+        sizes[i] = 0;
+}
+
+template <typename Row>
+typename SchemeArena<Row>::Factor SchemeArena<Row>::operator[](int matrix) {
+    return Factor(this, matrix);
+}
+
+template <typename Row>
+typename SchemeArena<Row>::ConstFactor SchemeArena<Row>::operator[](int matrix) const {
+    return ConstFactor(this, matrix);
+}
+
+template <typename Row>
+int SchemeArena<Row>::capacity() const {
+    return rows.size() / 3;
+}
+
+template <typename Row>
+void SchemeArena<Row>::reserve(int capacity) {
+    // term-major rows keep their positions when the arena grows
+    if (capacity > this->capacity())
+        rows.resize(capacity * 3);
+}
+
+template <typename Row>
+void SchemeArena<Row>::copy(const SchemeArena &arena) {
+    int terms = arena.getTerms();
+    reserve(arena.capacity());
+    std::copy(arena.rows.begin(), arena.rows.begin() + terms * 3, rows.begin());
+
+    for (int i = 0; i < 3; i++)
+        sizes[i] = arena.sizes[i];
+}
+
+template <typename Row>
+void SchemeArena<Row>::pack(std::ostream &os, int matrix) const {
+    writeBinary(os, uint64_t(sizes[matrix]));
+
+    for (int index = 0; index < sizes[matrix]; index++)
+        writeBinary(os, rows[index * 3 + matrix]);
+}
+
+template <typename Row>
+bool SchemeArena<Row>::unpack(std::istream &is, int matrix, int size) {
+    uint64_t packedSize;
+    if (!readBinary(is, packedSize) || packedSize != uint64_t(size))
+        return false;
+
+    reserve(size);
+
+    for (int index = 0; index < size; index++)
+        if (!readBinary(is, rows[index * 3 + matrix]))
+            return false;
+
+    sizes[matrix] = size;
+    return true;
+}
+
+template <typename Row>
+int SchemeArena<Row>::getTerms() const {
+    return std::max(sizes[0], std::max(sizes[1], sizes[2]));
+}
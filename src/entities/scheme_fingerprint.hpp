@@ -0,0 +1,69 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "bit_hash.hpp"
+
+struct SchemeFingerprint {
+    uint64_t low;
+    uint64_t high;
+
+    SchemeFingerprint() : low(0), high(0) {
+    }
+
+    explicit SchemeFingerprint(uint64_t hash) : low(mixBits(hash)), high(mixBits(hash ^ 0xD6E8FEB86659FD93ULL)) {
+    }
+
+    SchemeFingerprint& operator+=(const SchemeFingerprint &fingerprint) {
+        low += fingerprint.low;
+        high += fingerprint.high;
+        return *this;
+    }
+
+    SchemeFingerprint& operator-=(const SchemeFingerprint &fingerprint) {
+        low -= fingerprint.low;
+        high -= fingerprint.high;
+        return *this;
+    }
+
+    static SchemeFingerprint fromString(const std::string &value) {
+        SchemeFingerprint fingerprint;
+        uint64_t low = 0x9E3779B97F4A7C15ULL;
+        uint64_t high = 0xD6E8FEB86659FD93ULL;
+
+        for (size_t i = 0; i < value.size(); i += 8) {
+            uint64_t chunk = 0;
+            memcpy(&chunk, value.data() + i, std::min(value.size() - i, size_t(8)));
+            low = mixBits(low ^ chunk);
+            high = mixBits(high + chunk);
+        }
+
+        fingerprint.low = mixBits(low ^ value.size());
+        fingerprint.high = mixBits(high + value.size());
+        return fingerprint;
+    }
+
+    bool empty() const {
+        return !low && !high;
+    }
+
+    bool operator==(const SchemeFingerprint &fingerprint) const {
+        return low == fingerprint.low && high == fingerprint.high;
+    }
+
+    bool operator!=(const SchemeFingerprint &fingerprint) const {
+        return !(*this == fingerprint);
+    }
+
+    std::string toHex() const {
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0') << std::setw(16) << high << std::setw(16) << low;
+        return ss.str();
+    }
+};
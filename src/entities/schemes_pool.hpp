@@ -5,20 +5,22 @@
 #include <random>
 #include <string>
 #include <climits>
-#include <unordered_set>
 
 #include "../entities/sha1.h"
+#include "../entities/fingerprint_set.h"
+#include "../entities/weighted_sampler.h"
+#include "../entities/tiered_blob_store.h"
+#include "../entities/pool_snapshot.h"
 
 template <typename Scheme>
 class SchemesPool {
-    size_t maxSize;
     std::string uniqueType;
     std::string path;
     std::string format;
 
-    std::vector<Scheme> schemes;
-    std::vector<int> schemeFlips;
-    size_t totalFlips;
+    TieredBlobStore schemes;
+    std::vector<uint8_t> blob;
+    WeightedSampler sampler;
     size_t changes;
     size_t index;
     bool hasDirectory;
@@ -28,10 +30,10 @@ class SchemesPool {
     int minFlips;
     int maxFlips;
 
-    std::unordered_set<std::string> hashes;
+    FingerprintSet fingerprints;
     SHA1 sha1;
 public:
-    SchemesPool(size_t maxSize, const std::string uniqueType, const std::string &path, const std::string &format);
+    SchemesPool(size_t maxSize, const std::string uniqueType, const std::string &path, const std::string &format, const std::string &diskPath = "", size_t diskSize = 0);
 
     size_t size() const;
     size_t getDiff() const;
@@ -39,24 +41,31 @@ public:
     int getMaxComplexity() const;
     int getMinFlips() const;
     int getMaxFlips() const;
+    size_t getFingerprintsCount() const;
+    size_t getFingerprintsMemory() const;
+    size_t getMemory() const;
+    size_t getDiskUsage() const;
 
     bool add(const Scheme &scheme, bool save);
+    bool addPacked(const SchemeFingerprint &fingerprint, const std::vector<uint8_t> &packed, int complexity, int flips, bool &stored);
     bool contains(const Scheme &scheme) const;
-    void copyRandom(Scheme &scheme, std::mt19937 &generator, bool selectUniform = true) const;
+    void copyRandom(Scheme &scheme, RandomGenerator &generator, bool selectUniform = true) const;
     void resetDiff();
-private:
-    void saveScheme(const Scheme &scheme);
-    std::string getHash(const Scheme &scheme) const;
+
+    PoolSnapshotSection getSnapshotSection() const;
+    void writeSnapshot(std::ostream &os) const;
+    void readSnapshot(const PoolSnapshotSection &section, const uint8_t *data);
+
+    bool makeSaveDirectory();
+    void saveScheme(const Scheme &scheme) const;
 };
 
 template <typename Scheme>
-SchemesPool<Scheme>::SchemesPool(size_t maxSize, const std::string uniqueType, const std::string &path, const std::string &format) {
-    this->maxSize = maxSize;
+SchemesPool<Scheme>::SchemesPool(size_t maxSize, const std::string uniqueType, const std::string &path, const std::string &format, const std::string &diskPath, size_t diskSize) : schemes(maxSize, diskPath, diskSize) {
     this->uniqueType = uniqueType;
     this->path = path;
     this->format = format;
     this->index = 0;
-    this->totalFlips = 0;
     this->changes = 0;
     this->hasDirectory = false;
 
@@ -96,39 +105,68 @@ int SchemesPool<Scheme>::getMaxFlips() const {
     return maxFlips;
 }
 
+template <typename Scheme>
+size_t SchemesPool<Scheme>::getFingerprintsCount() const {
+    return fingerprints.size();
+}
+
+template <typename Scheme>
+size_t SchemesPool<Scheme>::getFingerprintsMemory() const {
+    return fingerprints.memoryUsage();
+}
+
+template <typename Scheme>
+size_t SchemesPool<Scheme>::getMemory() const {
+    return schemes.memoryUsage() + sampler.memoryUsage() + fingerprints.memoryUsage();
+}
+
+template <typename Scheme>
+size_t SchemesPool<Scheme>::getDiskUsage() const {
+    return schemes.diskUsage();
+}
+
 template <typename Scheme>
 bool SchemesPool<Scheme>::add(const Scheme &scheme, bool save) {
-    if (!uniqueType.empty()) {
-        std::string hash = sha1.get(getHash(scheme));
-        if (hashes.find(hash) != hashes.end())
-            return false;
+    SchemeFingerprint fingerprint;
+    if (!uniqueType.empty())
+        fingerprint = getUniqueFingerprint(scheme, uniqueType);
 
-        hashes.insert(hash);
-    }
+    scheme.packTerms(blob);
+
+    bool stored;
+    if (!addPacked(fingerprint, blob, scheme.getComplexity(), scheme.getAvailableFlips(), stored))
+        return false;
 
-    int complexity = scheme.getComplexity();
-    int flips = scheme.getAvailableFlips();
+    if (save && stored && makeSaveDirectory())
+        saveScheme(scheme);
+
+    return true;
+}
+
+template <typename Scheme>
+bool SchemesPool<Scheme>::addPacked(const SchemeFingerprint &fingerprint, const std::vector<uint8_t> &packed, int complexity, int flips, bool &stored) {
+    stored = false;
 
-    if (schemes.size() < maxSize) {
-        schemes.emplace_back(Scheme());
-        schemeFlips.push_back(flips);
+    if (!uniqueType.empty() && !fingerprints.insert(fingerprint))
+        return false;
 
-        if (save)
-            saveScheme(scheme);
+    if (schemes.canPush()) {
+        schemes.push(packed);
+        sampler.push(flips);
+        stored = true;
     }
     else {
-        totalFlips -= schemeFlips[index];
-        schemeFlips[index] = flips;
+        schemes.set(index, packed);
+        sampler.set(index, flips);
     }
 
-    schemes[index].copy(scheme);
-    index = (index + 1) % maxSize;
+    // when both tiers are full, the oldest schemes of the memory and the disk tiers are overwritten in turn
+    index = (index + 1) % schemes.capacity();
 
     minComplexity = std::min(minComplexity, complexity);
     maxComplexity = std::max(maxComplexity, complexity);
     minFlips = std::min(minFlips, flips);
     maxFlips = std::max(maxFlips, flips);
-    totalFlips += flips;
     changes++;
 
     return true;
@@ -136,46 +174,109 @@ bool SchemesPool<Scheme>::add(const Scheme &scheme, bool save) {
 
 template <typename Scheme>
 bool SchemesPool<Scheme>::contains(const Scheme &scheme) const {
-    std::string hash = getHash(scheme);
-    return hashes.find(hash) != hashes.end();
+    if (uniqueType.empty())
+        return false;
+
+    return fingerprints.contains(getUniqueFingerprint(scheme, uniqueType));
 }
 
 template <typename Scheme>
-void SchemesPool<Scheme>::copyRandom(Scheme &scheme, std::mt19937 &generator, bool selectUniform) const {
-    if (totalFlips == 0 || selectUniform) {
-        scheme.copy(schemes[generator() % schemes.size()]);
+void SchemesPool<Scheme>::copyRandom(Scheme &scheme, RandomGenerator &generator, bool selectUniform) const {
+    if (sampler.total() == 0 || selectUniform) {
+        size_t index = generator() % schemes.size();
+        scheme.unpackTerms(schemes.get(index), schemes.getSize(index));
         return;
     }
 
-    std::uniform_int_distribution<size_t> uniform(0, totalFlips);
+    std::uniform_int_distribution<size_t> uniform(0, sampler.total() - 1);
+    size_t index = sampler.sample(uniform(generator));
+    scheme.unpackTerms(schemes.get(index), schemes.getSize(index));
+}
+
+template <typename Scheme>
+void SchemesPool<Scheme>::resetDiff() {
+    changes = 0;
+}
+
+template <typename Scheme>
+PoolSnapshotSection SchemesPool<Scheme>::getSnapshotSection() const {
+    PoolSnapshotSection section;
+    section.count = schemes.size();
+    section.recordSize = schemes.size() ? schemes.getSize(0) : 0;
+    section.fingerprints = fingerprints.size();
+    section.index = index;
+    section.minComplexity = minComplexity;
+    section.maxComplexity = maxComplexity;
+    section.minFlips = minFlips;
+    section.maxFlips = maxFlips;
+    return section;
+}
+
+template <typename Scheme>
+void SchemesPool<Scheme>::writeSnapshot(std::ostream &os) const {
+    size_t recordSize = schemes.size() ? schemes.getSize(0) : 0;
+
+    for (size_t i = 0; i < schemes.size(); i++)
+        os.write(reinterpret_cast<const char *>(schemes.get(i)), recordSize);
+
+    for (size_t i = 0; i < schemes.size(); i++)
+        writeBinary(os, int32_t(sampler.weight(i)));
+
+    std::vector<SchemeFingerprint> values;
+    fingerprints.getValues(values);
+
+    for (const SchemeFingerprint &fingerprint : values)
+        writeBinary(os, fingerprint);
+}
+
+template <typename Scheme>
+void SchemesPool<Scheme>::readSnapshot(const PoolSnapshotSection &section, const uint8_t *data) {
+    const uint8_t *flipsData = data + section.count * section.recordSize;
+    const uint8_t *fingerprintsData = flipsData + section.count * sizeof(int32_t);
+    bool checkUnique = !uniqueType.empty() && schemes.size() > 0;
+
+    for (size_t i = 0; i < section.count && schemes.canPush(); i++) {
+        int32_t flips;
+        readBlob(flipsData, flips);
 
-    size_t randomWeight = uniform(generator);
-    size_t sum = 0;
+        const uint8_t *record = data + i * section.recordSize;
 
-    for (size_t i = 0; i < schemes.size(); i++) {
-        sum += schemeFlips[i];
+        if (checkUnique) {
+            Scheme scheme;
+            scheme.unpackTerms(record, section.recordSize);
 
-        if (randomWeight <= sum) {
-            scheme.copy(schemes[i]);
-            return;
+            if (!fingerprints.insert(getUniqueFingerprint(scheme, uniqueType)))
+                continue;
         }
+
+        blob.assign(record, record + section.recordSize);
+        schemes.push(blob);
+        sampler.push(flips);
+    }
+
+    for (size_t i = 0; i < section.fingerprints; i++) {
+        SchemeFingerprint fingerprint;
+        readBlob(fingerprintsData, fingerprint);
+        fingerprints.insert(fingerprint);
     }
 
-    scheme.copy(schemes.back());
+    index = section.index % schemes.capacity();
+    minComplexity = std::min(minComplexity, section.minComplexity);
+    maxComplexity = std::max(maxComplexity, section.maxComplexity);
+    minFlips = std::min(minFlips, section.minFlips);
+    maxFlips = std::max(maxFlips, section.maxFlips);
 }
 
 template <typename Scheme>
-void SchemesPool<Scheme>::resetDiff() {
-    changes = 0;
+bool SchemesPool<Scheme>::makeSaveDirectory() {
+    if (!hasDirectory)
+        hasDirectory = makeDirectory(path);
+
+    return hasDirectory;
 }
 
 template <typename Scheme>
-void SchemesPool<Scheme>::saveScheme(const Scheme &scheme) {
-    if (!hasDirectory && !std::filesystem::exists(path)) {
-        makeDirectory(path);
-        hasDirectory = true;
-    }
-
+void SchemesPool<Scheme>::saveScheme(const Scheme &scheme) const {
     std::stringstream ss;
     ss << path << "/";
     ss << scheme.getDimension();
@@ -189,14 +290,3 @@ void SchemesPool<Scheme>::saveScheme(const Scheme &scheme) {
     else
         scheme.saveTxt(ss.str());
 }
-
-template <typename Scheme>
-std::string SchemesPool<Scheme>::getHash(const Scheme &scheme) const {
-    if (uniqueType == "structure")
-        return scheme.getStructureHash();
-
-    if (uniqueType == "type")
-        return scheme.getTypeInvariant();
-
-    return scheme.getHash();
-}
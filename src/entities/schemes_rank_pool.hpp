@@ -19,39 +19,52 @@ class SchemesRankPool {
     std::string uniqueType;
     std::string path;
     std::string format;
+    std::string diskPath;
+    size_t diskSize;
 
     std::vector<int> ranks;
     std::unordered_map<int, SchemesPool<Scheme>> rank2pool;
 public:
-    SchemesRankPool(const std::string &dimension, size_t maxSize, const std::string &uniqueType, const std::string &path, const std::string &format);
+    SchemesRankPool(const std::string &dimension, size_t maxSize, const std::string &uniqueType, const std::string &path, const std::string &format, const std::string &diskPath = "", size_t diskSize = 0);
 
     int minRank() const;
     int maxRank() const;
+    const std::vector<int>& getRanks() const;
+    const SchemesPool<Scheme>& getPool(int rank) const;
 
     size_t minRankSize() const;
     size_t size(int rank) const;
     size_t size() const;
+    size_t getFingerprintsCount() const;
+    size_t getFingerprintsMemory() const;
+    size_t getMemory() const;
+    size_t getDiskUsage() const;
 
     double minFillRatio() const;
     double fillRatio(int rank) const;
 
     bool add(const Scheme &scheme, bool save = false);
     bool contains(const Scheme &scheme) const;
-    void copyRandom(Scheme &scheme, std::mt19937 &generator, double alpha) const;
-    void copyRandomMinRank(Scheme &scheme, std::mt19937 &generator) const;
+    void copyRandom(Scheme &scheme, RandomGenerator &generator, double alpha) const;
+    void copyRandomMinRank(Scheme &scheme, RandomGenerator &generator) const;
     void resetDiff();
     size_t print(int knownRank) const;
+
+    void readSnapshot(const PoolSnapshotSection &section, const uint8_t *data);
+    SchemesPool<Scheme>& createPool(int rank);
 private:
-    int getRandomRank(std::mt19937 &generator, double alpha) const;
+    int getRandomRank(RandomGenerator &generator, double alpha) const;
 };
 
 template <typename Scheme>
-SchemesRankPool<Scheme>::SchemesRankPool(const std::string &dimension, size_t maxSize, const std::string &uniqueType, const std::string &path, const std::string &format) {
+SchemesRankPool<Scheme>::SchemesRankPool(const std::string &dimension, size_t maxSize, const std::string &uniqueType, const std::string &path, const std::string &format, const std::string &diskPath, size_t diskSize) {
     this->dimension = dimension;
     this->maxSize = maxSize;
     this->uniqueType = uniqueType;
     this->path = path;
     this->format = format;
+    this->diskPath = diskPath;
+    this->diskSize = diskSize;
 }
 
 template <typename Scheme>
@@ -70,6 +83,16 @@ int SchemesRankPool<Scheme>::maxRank() const {
     return ranks.back();
 }
 
+template <typename Scheme>
+const std::vector<int>& SchemesRankPool<Scheme>::getRanks() const {
+    return ranks;
+}
+
+template <typename Scheme>
+const SchemesPool<Scheme>& SchemesRankPool<Scheme>::getPool(int rank) const {
+    return rank2pool.at(rank);
+}
+
 template <typename Scheme>
 size_t SchemesRankPool<Scheme>::minRankSize() const {
     if (ranks.empty())
@@ -96,34 +119,62 @@ size_t SchemesRankPool<Scheme>::size() const {
     return total;
 }
 
+template <typename Scheme>
+size_t SchemesRankPool<Scheme>::getFingerprintsCount() const {
+    size_t total = 0;
+
+    for (const auto& pair : rank2pool)
+        total += pair.second.getFingerprintsCount();
+
+    return total;
+}
+
+template <typename Scheme>
+size_t SchemesRankPool<Scheme>::getFingerprintsMemory() const {
+    size_t total = 0;
+
+    for (const auto& pair : rank2pool)
+        total += pair.second.getFingerprintsMemory();
+
+    return total;
+}
+
+template <typename Scheme>
+size_t SchemesRankPool<Scheme>::getMemory() const {
+    size_t total = 0;
+
+    for (const auto& pair : rank2pool)
+        total += pair.second.getMemory();
+
+    return total;
+}
+
+template <typename Scheme>
+size_t SchemesRankPool<Scheme>::getDiskUsage() const {
+    size_t total = 0;
+
+    for (const auto& pair : rank2pool)
+        total += pair.second.getDiskUsage();
+
+    return total;
+}
+
 template <typename Scheme>
 double SchemesRankPool<Scheme>::minFillRatio() const {
     if (ranks.empty())
         return 0;
 
-    return rank2pool.at(ranks[0]).size() / double(maxSize);
+    return std::min(1.0, rank2pool.at(ranks[0]).size() / double(maxSize));
 }
 
 template <typename Scheme>
 double SchemesRankPool<Scheme>::fillRatio(int rank) const {
-    return size(rank) / double(maxSize);
+    return std::min(1.0, size(rank) / double(maxSize));
 }
 
 template <typename Scheme>
 bool SchemesRankPool<Scheme>::add(const Scheme &scheme, bool save) {
-    int rank = scheme.getRank();
-
-    if (rank2pool.find(rank) == rank2pool.end()) {
-        std::stringstream ss;
-        ss << path << "/rank" << rank;
-        std::string rankPath = ss.str();
-
-        rank2pool.emplace(rank, SchemesPool<Scheme>(maxSize, uniqueType, rankPath, format));
-        ranks.push_back(rank);
-        std::sort(ranks.begin(), ranks.end());
-    }
-
-    return rank2pool.at(rank).add(scheme, save);
+    return createPool(scheme.getRank()).add(scheme, save);
 }
 
 template <typename Scheme>
@@ -139,7 +190,7 @@ bool SchemesRankPool<Scheme>::contains(const Scheme &scheme) const {
 template <typename Scheme>
 size_t SchemesRankPool<Scheme>::print(int knownRank) const {
     size_t totalDiff = 0;
-    std::cout << "+-----------+------+-----------------+---------------+-------------------+" << std::endl;
+    std::cout << "+-----------+------+-----------------+---------------+-------------------+------------+" << std::endl;
 
     for (size_t i = 0; i < ranks.size(); i++) {
         const auto& pool = rank2pool.at(ranks[i]);
@@ -158,7 +209,8 @@ size_t SchemesRankPool<Scheme>::print(int knownRank) const {
         std::cout << std::setw(5) << pool.getMinComplexity() << " | ";
         std::cout << std::setw(5) << pool.getMaxComplexity() << " | ";
         std::cout << std::setw(7) << pool.getMinFlips() << " | ";
-        std::cout << std::setw(7) << pool.getMaxFlips();
+        std::cout << std::setw(7) << pool.getMaxFlips() << " | ";
+        std::cout << std::setw(10) << (i == 0 ? prettyBytes(getMemory()) : "");
         std::cout << " |";
 
         if (i == 0) {
@@ -175,7 +227,27 @@ size_t SchemesRankPool<Scheme>::print(int knownRank) const {
 }
 
 template <typename Scheme>
-int SchemesRankPool<Scheme>::getRandomRank(std::mt19937 &generator, double alpha) const {
+void SchemesRankPool<Scheme>::readSnapshot(const PoolSnapshotSection &section, const uint8_t *data) {
+    createPool(section.rank).readSnapshot(section, data);
+}
+
+template <typename Scheme>
+SchemesPool<Scheme>& SchemesRankPool<Scheme>::createPool(int rank) {
+    auto it = rank2pool.find(rank);
+    if (it != rank2pool.end())
+        return it->second;
+
+    std::stringstream ss;
+    ss << path << "/rank" << rank;
+    std::string rankPath = ss.str();
+
+    ranks.push_back(rank);
+    std::sort(ranks.begin(), ranks.end());
+    return rank2pool.emplace(rank, SchemesPool<Scheme>(maxSize, uniqueType, rankPath, format, diskPath, diskSize)).first->second;
+}
+
+template <typename Scheme>
+int SchemesRankPool<Scheme>::getRandomRank(RandomGenerator &generator, double alpha) const {
     std::vector<double> weights(ranks.size());
     weights[0] = 1.0;
 
@@ -202,13 +274,13 @@ int SchemesRankPool<Scheme>::getRandomRank(std::mt19937 &generator, double alpha
 }
 
 template <typename Scheme>
-void SchemesRankPool<Scheme>::copyRandom(Scheme &scheme, std::mt19937 &generator, double alpha) const {
+void SchemesRankPool<Scheme>::copyRandom(Scheme &scheme, RandomGenerator &generator, double alpha) const {
     int rank = getRandomRank(generator, alpha);
     rank2pool.at(rank).copyRandom(scheme, generator);
 }
 
 template <typename Scheme>
-void SchemesRankPool<Scheme>::copyRandomMinRank(Scheme &scheme, std::mt19937 &generator) const {
+void SchemesRankPool<Scheme>::copyRandomMinRank(Scheme &scheme, RandomGenerator &generator) const {
     rank2pool.at(ranks[0]).copyRandom(scheme, generator);
 }
 
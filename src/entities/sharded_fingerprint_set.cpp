@@ -0,0 +1,71 @@
+#include "sharded_fingerprint_set.h"
+
+ShardedFingerprintSet::ShardedFingerprintSet(int shards) {
+    this->shards.resize(shards);
+    this->mutexes.reset(new std::mutex[shards]);
+}
+
+int ShardedFingerprintSet::getShards() const {
+    return shards.size();
+}
+
+int ShardedFingerprintSet::getShard(const SchemeFingerprint &fingerprint) const {
+    return fingerprint.high % shards.size();
+}
+
+size_t ShardedFingerprintSet::size() const {
+    size_t total = 0;
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(mutexes[i]);
+        total += shards[i].size();
+    }
+
+    return total;
+}
+
+size_t ShardedFingerprintSet::capacity() const {
+    size_t total = 0;
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(mutexes[i]);
+        total += shards[i].capacity();
+    }
+
+    return total;
+}
+
+size_t ShardedFingerprintSet::memoryUsage() const {
+    size_t total = sizeof(ShardedFingerprintSet) + shards.size() * sizeof(std::mutex);
+
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(mutexes[i]);
+        total += shards[i].memoryUsage();
+    }
+
+    return total;
+}
+
+bool ShardedFingerprintSet::insert(const SchemeFingerprint &fingerprint) {
+    int shard = getShard(fingerprint);
+    std::lock_guard<std::mutex> lock(mutexes[shard]);
+    return shards[shard].insert(fingerprint);
+}
+
+// the caller must be the only writer of the shard, e.g. when inserting a batch grouped by shards
+bool ShardedFingerprintSet::insertUnlocked(int shard, const SchemeFingerprint &fingerprint) {
+    return shards[shard].insert(fingerprint);
+}
+
+bool ShardedFingerprintSet::contains(const SchemeFingerprint &fingerprint) const {
+    int shard = getShard(fingerprint);
+    std::lock_guard<std::mutex> lock(mutexes[shard]);
+    return shards[shard].contains(fingerprint);
+}
+
+void ShardedFingerprintSet::clear() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(mutexes[i]);
+        shards[i].clear();
+    }
+}
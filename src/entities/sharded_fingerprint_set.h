@@ -0,0 +1,27 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "fingerprint_set.h"
+
+class ShardedFingerprintSet {
+    std::vector<FingerprintSet> shards;
+    std::unique_ptr<std::mutex[]> mutexes;
+public:
+    ShardedFingerprintSet(int shards = 64);
+
+    int getShards() const;
+    int getShard(const SchemeFingerprint &fingerprint) const;
+
+    size_t size() const;
+    size_t capacity() const;
+    size_t memoryUsage() const;
+
+    bool insert(const SchemeFingerprint &fingerprint);
+    bool insertUnlocked(int shard, const SchemeFingerprint &fingerprint);
+    bool contains(const SchemeFingerprint &fingerprint) const;
+    void clear();
+};
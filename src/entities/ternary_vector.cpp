@@ -1,5 +1,5 @@
 #include "ternary_vector.hpp"
-#include "uint256_t.h"
+#include "bit_vector.hpp"
 
 template <typename T>
 int TernaryVector<T>::nonZeroCount() const {
@@ -16,8 +16,20 @@ int TernaryVector<uint256_t>::nonZeroCount() const {
     return values.popcount();
 }
 
+template <>
+int TernaryVector<uint512_t>::nonZeroCount() const {
+    return values.popcount();
+}
+
+template <>
+int TernaryVector<uint1024_t>::nonZeroCount() const {
+    return values.popcount();
+}
+
 template class TernaryVector<uint16_t>;
 template class TernaryVector<uint32_t>;
 template class TernaryVector<uint64_t>;
 template class TernaryVector<__uint128_t>;
 template class TernaryVector<uint256_t>;
+template class TernaryVector<uint512_t>;
+template class TernaryVector<uint1024_t>;
@@ -1,12 +1,12 @@
 #pragma once
 
-#include "uint256_t.h"
+#include "bit_vector.hpp"
 
 template <typename T>
 struct TernaryVector {
-    int n;
     T values;
     T signs;
+    int n;
     bool valid;
 
     TernaryVector();
@@ -0,0 +1,71 @@
+#include "tiered_blob_store.h"
+
+TieredBlobStore::TieredBlobStore(size_t memoryLimit, const std::string &diskDirectory, size_t diskLimit) : disk(diskDirectory) {
+    this->memoryLimit = memoryLimit;
+    this->diskLimit = diskLimit;
+    this->hasDisk = !diskDirectory.empty();
+}
+
+size_t TieredBlobStore::size() const {
+    return memory.size() + disk.size();
+}
+
+size_t TieredBlobStore::capacity() const {
+    if (!hasDisk)
+        return memoryLimit;
+
+    return memoryLimit + std::min(diskLimit, SIZE_MAX - memoryLimit);
+}
+
+size_t TieredBlobStore::memorySize() const {
+    return memory.size();
+}
+
+size_t TieredBlobStore::diskSize() const {
+    return disk.size();
+}
+
+size_t TieredBlobStore::memoryUsage() const {
+    return memory.memoryUsage();
+}
+
+size_t TieredBlobStore::diskUsage() const {
+    return disk.fileSize();
+}
+
+bool TieredBlobStore::canPush() const {
+    return memory.size() < memoryLimit || (hasDisk && disk.size() < diskLimit);
+}
+
+void TieredBlobStore::push(const std::vector<uint8_t> &blob) {
+    if (memory.size() < memoryLimit || !hasDisk)
+        memory.push(blob);
+    else
+        disk.push(blob);
+}
+
+void TieredBlobStore::set(size_t index, const std::vector<uint8_t> &blob) {
+    if (index < memory.size())
+        memory.set(index, blob);
+    else
+        disk.set(index - memory.size(), blob);
+}
+
+const uint8_t* TieredBlobStore::get(size_t index) const {
+    if (index < memory.size())
+        return memory.get(index);
+
+    return disk.get(index - memory.size());
+}
+
+size_t TieredBlobStore::getSize(size_t index) const {
+    if (index < memory.size())
+        return memory.getSize(index);
+
+    return disk.getRecordSize();
+}
+
+void TieredBlobStore::clear() {
+    memory.clear();
+    disk.clear();
+}
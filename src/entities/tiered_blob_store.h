@@ -0,0 +1,33 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "blob_arena.h"
+#include "mapped_blob_file.h"
+
+class TieredBlobStore {
+    BlobArena memory;
+    MappedBlobFile disk;
+    size_t memoryLimit;
+    size_t diskLimit;
+    bool hasDisk;
+public:
+    TieredBlobStore(size_t memoryLimit = SIZE_MAX, const std::string &diskDirectory = "", size_t diskLimit = SIZE_MAX);
+
+    size_t size() const;
+    size_t capacity() const;
+    size_t memorySize() const;
+    size_t diskSize() const;
+    size_t memoryUsage() const;
+    size_t diskUsage() const;
+    bool canPush() const;
+
+    void push(const std::vector<uint8_t> &blob);
+    void set(size_t index, const std::vector<uint8_t> &blob);
+    const uint8_t* get(size_t index) const;
+    size_t getSize(size_t index) const;
+    void clear();
+};
@@ -0,0 +1,68 @@
+#include "weighted_sampler.h"
+
+WeightedSampler::WeightedSampler() {
+    tree.push_back(0);
+    totalWeight = 0;
+    step = 0;
+}
+
+size_t WeightedSampler::size() const {
+    return weights.size();
+}
+
+size_t WeightedSampler::total() const {
+    return totalWeight;
+}
+
+size_t WeightedSampler::weight(size_t index) const {
+    return weights[index];
+}
+
+size_t WeightedSampler::memoryUsage() const {
+    return sizeof(WeightedSampler) + (weights.capacity() + tree.capacity()) * sizeof(size_t);
+}
+
+void WeightedSampler::push(size_t weight) {
+    weights.push_back(weight);
+
+    size_t index = weights.size();
+    size_t sum = weight;
+
+    for (size_t offset = 1; offset < (index & -index); offset <<= 1)
+        sum += tree[index - offset];
+
+    tree.push_back(sum);
+    totalWeight += weight;
+
+    if (step * 2 <= index)
+        step = step ? step * 2 : 1;
+}
+
+void WeightedSampler::set(size_t index, size_t weight) {
+    size_t prev = weights[index];
+    weights[index] = weight;
+    totalWeight = totalWeight - prev + weight;
+
+    for (size_t i = index + 1; i < tree.size(); i += i & -i)
+        tree[i] = tree[i] - prev + weight;
+}
+
+void WeightedSampler::clear() {
+    weights.clear();
+    tree.assign(1, 0);
+    totalWeight = 0;
+    step = 0;
+}
+
+size_t WeightedSampler::sample(size_t value) const {
+    size_t index = 0;
+
+    for (size_t offset = step; offset; offset >>= 1) {
+        if (index + offset < tree.size() && tree[index + offset] <= value) {
+            index += offset;
+            value -= tree[index];
+        }
+    }
+
+    return index < weights.size() ? index : weights.size() - 1;
+}
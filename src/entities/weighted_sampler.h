@@ -0,0 +1,25 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+class WeightedSampler {
+    std::vector<size_t> weights;
+    std::vector<size_t> tree;
+    size_t totalWeight;
+    size_t step;
+public:
+    WeightedSampler();
+
+    size_t size() const;
+    size_t total() const;
+    size_t weight(size_t index) const;
+    size_t memoryUsage() const;
+
+    void push(size_t weight);
+    void set(size_t index, size_t weight);
+    void clear();
+
+    size_t sample(size_t value) const;
+};
@@ -7,19 +7,40 @@
 #include <string>
 #include <random>
 #include <vector>
+#include <atomic>
+#include <thread>
 #include <omp.h>
 
 #include "utils.h"
+#include "entities/checkpoint.h"
+#include "entities/numa_topology.h"
+#include "entities/operation_counters.h"
 #include "parameters/flip_parameters.h"
 #include "parameters/metrics_parameters.h"
+#include "parameters/checkpoint_parameters.h"
 
 template <typename Scheme>
 class FlipGraph {
+    struct alignas(64) Runner {
+        Scheme scheme;
+        Scheme schemeBest;
+        RandomGenerator generator;
+        size_t flips;
+        size_t iterations;
+        size_t plusIterations;
+        int bestRank;
+        bool copiedBest;
+
+        Runner(const RandomGenerator &generator) : generator(generator), flips(0), iterations(0), plusIterations(0), bestRank(0), copiedBest(false) {}
+    };
+
     int count;
     std::string outputPath;
     int threads;
+    bool numa;
     FlipParameters flipParameters;
     MetricsParameters metricsParameters;
+    CheckpointParameters checkpointParameters;
     double copyBestProbability;
     int seed;
     int topCount;
@@ -27,53 +48,70 @@ class FlipGraph {
     size_t improvementsIndex;
     std::string format;
 
-    std::vector<Scheme> schemes;
-    std::vector<Scheme> schemesBest;
+    std::vector<std::unique_ptr<Runner>> runners;
     std::vector<Scheme> improvements;
-    std::vector<size_t> flips;
-    std::vector<size_t> iterations;
-    std::vector<size_t> plusIterations;
-    std::vector<int> bestRanks;
     std::vector<int> indices;
     int bestRank;
+    int targetRank;
+    std::atomic<bool> targetReached;
+    size_t startIteration;
+    bool resumed;
+    CheckpointWriter checkpointWriter;
+    NumaTopology topology;
+    std::vector<size_t> nodeFlips;
+    std::vector<double> nodeTimes;
+    OperationCounters lastCounters;
+    OperationCounters iterationCounters;
+    double iterationTime;
 
-    std::vector<std::mt19937> generators;
     std::uniform_real_distribution<double> uniform;
     std::uniform_int_distribution<size_t> plusDistribution;
 public:
-    FlipGraph(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetricsParameters &metricsParameters, double copyBestProbability, int seed, int topCount, size_t maxImprovements, const std::string &format);
+    FlipGraph(int count, const std::string outputPath, int threads, bool numa, const FlipParameters &flipParameters, const MetricsParameters &metricsParameters, const CheckpointParameters &checkpointParameters, double copyBestProbability, int seed, const std::string &generatorType, int topCount, size_t maxImprovements, const std::string &format);
 
     bool initializeNaive(int n1, int n2, int n3);
     bool initializeFromFile(const std::string &path, bool multiple, bool checkCorrectness);
+    bool initializeFromCheckpoint(const std::string &path);
 
     void run(int targetRank);
+    void runAsync(int targetRank);
 private:
     void resetImprovements();
     void addImprovement(const Scheme &scheme);
 
     void initialize();
     void runIteration();
+    void runNumaIteration();
+    void placeRunners();
+    size_t getNodeFlips(int node) const;
+    OperationCounters getCounters() const;
+    void updateCounters(double elapsed);
     void updateBest(size_t iteration);
-    void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes) const;
-    void randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, int &bestRank, std::mt19937 &generator);
+    void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes, std::ostream &os) const;
+    void randomWalk(Runner &runner);
 
     bool compare(int index1, int index2) const;
     std::string getSavePath(const Scheme &scheme, int iteration, const std::string path) const;
 
     void saveScheme(const Scheme &scheme, const std::string &path) const;
+    void saveCheckpoint(size_t iteration);
 
     void initializeMetrics();
     void evaluateMetrics(const std::vector<int> &values, std::ostream &os, const std::string &name) const;
     void saveMetrics(size_t iteration) const;
+    void writeMetrics(size_t iteration, std::ostream &os) const;
+    void appendMetrics(const std::string &metrics) const;
 };
 
 template <typename Scheme>
-FlipGraph<Scheme>::FlipGraph(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetricsParameters &metricsParameters, double copyBestProbability, int seed, int topCount, size_t maxImprovements, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
+FlipGraph<Scheme>::FlipGraph(int count, const std::string outputPath, int threads, bool numa, const FlipParameters &flipParameters, const MetricsParameters &metricsParameters, const CheckpointParameters &checkpointParameters, double copyBestProbability, int seed, const std::string &generatorType, int topCount, size_t maxImprovements, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
     this->count = count;
     this->outputPath = outputPath;
     this->threads = std::min(threads, count);
+    this->numa = numa;
     this->flipParameters = flipParameters;
     this->metricsParameters = metricsParameters;
+    this->checkpointParameters = checkpointParameters;
     this->copyBestProbability = copyBestProbability;
     this->seed = seed;
     this->topCount = std::min(topCount, count);
@@ -82,30 +120,32 @@ FlipGraph<Scheme>::FlipGraph(int count, const std::string outputPath, int thread
 
     resetImprovements();
 
-    generators = initRandomGenerators(seed, threads);
-
-    schemes.resize(count);
-    schemesBest.resize(count);
-    bestRanks.resize(count);
-    flips.resize(count);
-    iterations.resize(count);
-    plusIterations.resize(count);
+    runners = initRunners<Runner>(seed, count, generatorType, this->threads);
     indices.resize(count);
+    targetRank = 0;
+    targetReached = false;
+    startIteration = 0;
+    resumed = false;
+    iterationTime = 0;
+
+    topology.partition(this->threads, count);
+    nodeFlips.resize(topology.getNodesCount());
+    nodeTimes.resize(topology.getNodesCount());
 }
 
 template <typename Scheme>
 bool FlipGraph<Scheme>::initializeNaive(int n1, int n2, int n3) {
     std::cout << "Start initializing with naive " << n1 << "x" << n2 << "x" << n3 << " schemes" << std::endl;
 
-    if (!schemes[0].initializeNaive(n1, n2, n3))
+    if (!runners[0]->scheme.initializeNaive(n1, n2, n3))
         return false;
 
     #pragma omp parallel for num_threads(threads)
     for (int i = 1; i < count; i++)
-        schemes[i].initializeNaive(n1, n2, n3);
+        runners[i]->scheme.initializeNaive(n1, n2, n3);
 
     resetImprovements();
-    addImprovement(schemes[0]);
+    addImprovement(runners[0]->scheme);
     return true;
 }
 
@@ -126,7 +166,7 @@ bool FlipGraph<Scheme>::initializeFromFile(const std::string &path, bool multipl
 
     bool valid = true;
     for (int i = 0; i < schemesCount && i < count && valid; i++)
-        valid = schemes[i].read(f, checkCorrectness);
+        valid = runners[i]->scheme.read(f, checkCorrectness);
 
     f.close();
 
@@ -135,34 +175,253 @@ bool FlipGraph<Scheme>::initializeFromFile(const std::string &path, bool multipl
 
     resetImprovements();
     for (int i = 0; i <schemesCount && i < count && improvements.size() < maxImprovements; i++)
-        addImprovement(schemes[i]);
+        addImprovement(runners[i]->scheme);
 
     #pragma omp parallel for num_threads(threads)
     for (int i = schemesCount; i < count; i++)
-        schemes[i].copy(schemes[i % schemesCount]);
+        runners[i]->scheme.copy(runners[i % schemesCount]->scheme);
+
+    return true;
+}
+
+template <typename Scheme>
+bool FlipGraph<Scheme>::initializeFromCheckpoint(const std::string &path) {
+    std::ifstream f(path, std::ios::binary);
+
+    if (!f) {
+        std::cout << "Unable open file \"" << path << "\"" << std::endl;
+        return false;
+    }
+
+    CheckpointHeader header;
+    if (!header.read(f))
+        return false;
+
+    if (header.ring != runners[0]->scheme.getRing() || header.count != count) {
+        std::cout << "Checkpoint was saved for " << header.count << " runners in " << header.ring << ", but got " << count << " runners in " << runners[0]->scheme.getRing() << std::endl;
+        return false;
+    }
+
+    std::cout << "Start resuming " << count << " runners from checkpoint \"" << path << "\"" << std::endl;
+
+    uint64_t iteration, improvementsCount;
+    if (!readBinary(f, iteration) || !readBinary(f, bestRank) || !readBinary(f, improvementsIndex) || !readBinary(f, improvementsCount) || improvementsCount == 0 || !checkBinarySize(f, improvementsCount, 1)) {
+        std::cout << "Invalid checkpoint: truncated state" << std::endl;
+        return false;
+    }
+
+    improvements.resize(improvementsCount);
+    for (size_t i = 0; i < improvementsCount; i++) {
+        if (!improvements[i].unpack(f)) {
+            std::cout << "Invalid checkpoint: corrupted improvement " << i << std::endl;
+            return false;
+        }
+    }
+
+    if (improvements.size() > maxImprovements)
+        improvements.resize(maxImprovements);
+
+    improvementsIndex %= improvements.size();
 
+    for (int i = 0; i < count; i++) {
+        if (!runners[i]->scheme.unpack(f) || !runners[i]->schemeBest.unpack(f) || !runners[i]->generator.unpack(f)) {
+            std::cout << "Invalid checkpoint: corrupted state of runner " << i << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<size_t> flips, iterations, plusIterations;
+    std::vector<int> bestRanks;
+
+    if (!readBinary(f, flips) || !readBinary(f, iterations) || !readBinary(f, plusIterations) || !readBinary(f, bestRanks) || flips.size() != size_t(count) || iterations.size() != size_t(count) || plusIterations.size() != size_t(count) || bestRanks.size() != size_t(count)) {
+        std::cout << "Invalid checkpoint: truncated state" << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        runners[i]->flips = flips[i];
+        runners[i]->iterations = iterations[i];
+        runners[i]->plusIterations = plusIterations[i];
+        runners[i]->bestRank = bestRanks[i];
+    }
+
+    startIteration = iteration;
+    resumed = true;
+
+    std::cout << "Resumed at iteration " << startIteration << " with best rank " << bestRank << std::endl;
     return true;
 }
 
 template <typename Scheme>
 void FlipGraph<Scheme>::run(int targetRank) {
+    this->targetRank = targetRank;
     initialize();
 
+    if (numa) {
+        std::cout << topology << std::endl;
+        placeRunners();
+    }
+
+    lastCounters = getCounters();
+
     auto startTime = std::chrono::high_resolution_clock::now();
+    auto checkpointTime = startTime;
     std::vector<double> elapsedTimes;
 
-    for (size_t iteration = 0; bestRank > targetRank; iteration++) {
+    for (size_t iteration = startIteration; bestRank > targetRank; iteration++) {
         auto t1 = std::chrono::high_resolution_clock::now();
         runIteration();
+        updateCounters(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count() / 1000.0);
         saveMetrics(iteration + 1);
         updateBest(iteration);
+        targetReached = false;
         auto t2 = std::chrono::high_resolution_clock::now();
         elapsedTimes.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0);
 
-        report(iteration + 1, startTime, elapsedTimes);
+        report(iteration + 1, startTime, elapsedTimes, std::cout);
+
+        if (stopSignal) {
+            saveCheckpoint(iteration + 1);
+            break;
+        }
+
+        if (checkpointParameters.use && std::chrono::duration_cast<std::chrono::seconds>(t2 - checkpointTime).count() >= checkpointParameters.interval) {
+            saveCheckpoint(iteration + 1);
+            checkpointTime = t2;
+        }
     }
 }
 
+template <typename Scheme>
+void FlipGraph<Scheme>::runAsync(int targetRank) {
+    this->targetRank = targetRank;
+    initialize();
+
+    std::vector<std::unique_ptr<Runner>> walkRunners(count);
+    std::vector<omp_lock_t> locks(count);
+
+    #pragma omp parallel for num_threads(threads)
+    for (int i = 0; i < count; i++)
+        walkRunners[i] = std::make_unique<Runner>(*runners[i]);
+
+    for (int i = 0; i < count; i++)
+        omp_init_lock(&locks[i]);
+
+    lastCounters = getCounters();
+
+    std::atomic<size_t> tickets(0);
+    std::atomic<size_t> walks(0);
+    std::atomic<bool> stop(bestRank <= targetRank);
+    std::atomic<bool> targetPublished(false);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto checkpointTime = startTime;
+    std::vector<double> elapsedTimes;
+
+    #pragma omp parallel num_threads(threads + 1)
+    {
+        if (omp_get_thread_num() == 0) {
+            auto t1 = std::chrono::high_resolution_clock::now();
+
+            for (size_t iteration = startIteration; !stop; iteration++) {
+                while (walks < (iteration + 1 - startIteration) * count && !targetPublished && !stopSignal)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                // only the snapshot of runners is taken under the lock, printing and writing metrics do not stall walkers
+                std::stringstream reportStream;
+                std::stringstream metricsStream;
+
+                #pragma omp critical(flipGraphPublish)
+                {
+                    updateCounters(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count() / 1000.0);
+
+                    if (metricsParameters.use)
+                        writeMetrics(iteration + 1, metricsStream);
+
+                    updateBest(iteration);
+                    auto t2 = std::chrono::high_resolution_clock::now();
+                    elapsedTimes.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0);
+                    t1 = t2;
+
+                    report(iteration + 1, startTime, elapsedTimes, reportStream);
+
+                    if (stopSignal || (checkpointParameters.use && std::chrono::duration_cast<std::chrono::seconds>(t2 - checkpointTime).count() >= checkpointParameters.interval)) {
+                        saveCheckpoint(iteration + 1);
+                        checkpointTime = t2;
+                    }
+                }
+
+                if (metricsParameters.use)
+                    appendMetrics(metricsStream.str());
+
+                std::cout << reportStream.str() << std::flush;
+
+                if (bestRank <= targetRank || stopSignal) {
+                    stop = true;
+                }
+                else {
+                    targetReached = false;
+                    targetPublished = false;
+                }
+            }
+        }
+        else {
+            while (!stop) {
+                int i = tickets++ % count;
+                if (!omp_test_lock(&locks[i])) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                Runner &runner = *runners[i];
+                Runner &walk = *walkRunners[i];
+
+                #pragma omp critical(flipGraphPublish)
+                if (runner.copiedBest) {
+                    walk.scheme.copy(runner.scheme);
+                    walk.schemeBest.copy(runner.schemeBest);
+                    walk.flips = runner.flips;
+                    walk.iterations = runner.iterations;
+                    walk.bestRank = runner.bestRank;
+                    runner.copiedBest = false;
+                }
+
+                randomWalk(walk);
+
+                #pragma omp critical(flipGraphPublish)
+                {
+                    runner.generator = walk.generator;
+
+                    // copy does not carry counters, so the operations of the walk are reported through the runner even if its state is dropped
+                    runner.scheme.copyCounters(walk.scheme);
+
+                    // updateBest may have copied the best scheme into this runner during the walk, then only the current state of the walk is dropped
+                    if (!runner.copiedBest) {
+                        runner.scheme.copy(walk.scheme);
+                        runner.flips = walk.flips;
+                        runner.iterations = walk.iterations;
+                        runner.plusIterations = walk.plusIterations;
+                    }
+
+                    if (!runner.copiedBest || walk.bestRank < runner.schemeBest.getRank()) {
+                        runner.schemeBest.copy(walk.schemeBest);
+                        runner.bestRank = walk.bestRank;
+                    }
+
+                    if (runner.bestRank <= targetRank)
+                        targetPublished = true;
+                }
+
+                omp_unset_lock(&locks[i]);
+                walks++;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+        omp_destroy_lock(&locks[i]);
+}
+
 template <typename Scheme>
 void FlipGraph<Scheme>::resetImprovements() {
     improvements.clear();
@@ -183,19 +442,29 @@ void FlipGraph<Scheme>::addImprovement(const Scheme &scheme) {
 
 template <typename Scheme>
 void FlipGraph<Scheme>::initialize() {
-    bestRank = schemes[0].getRank();
+    if (checkpointParameters.use)
+        handleStopSignals();
+
+    if (resumed) {
+        for (int i = 0; i < count; i++)
+            indices[i] = i;
+
+        return;
+    }
+
+    bestRank = runners[0]->scheme.getRank();
 
     #pragma omp parallel for num_threads(threads)
     for (int i = 0; i < count; i++) {
-        int rank = schemes[i].getRank();
+        int rank = runners[i]->scheme.getRank();
         if (rank < bestRank)
             bestRank = rank;
 
-        schemesBest[i].copy(schemes[i]);
-        bestRanks[i] = rank;
-        flips[i] = 0;
-        iterations[i] = 0;
-        plusIterations[i] = plusDistribution(generators[omp_get_thread_num()]);
+        runners[i]->schemeBest.copy(runners[i]->scheme);
+        runners[i]->bestRank = rank;
+        runners[i]->flips = 0;
+        runners[i]->iterations = 0;
+        runners[i]->plusIterations = plusDistribution(runners[i]->generator);
         indices[i] = i;
     }
 
@@ -205,9 +474,90 @@ void FlipGraph<Scheme>::initialize() {
 
 template <typename Scheme>
 void FlipGraph<Scheme>::runIteration()  {
-    #pragma omp parallel for num_threads(threads)
+    if (numa) {
+        runNumaIteration();
+        return;
+    }
+
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
     for (int i = 0; i < count; i++)
-        randomWalk(schemes[i], schemesBest[i], flips[i], iterations[i], plusIterations[i], bestRanks[i], generators[omp_get_thread_num()]);
+        randomWalk(*runners[i]);
+}
+
+template <typename Scheme>
+void FlipGraph<Scheme>::runNumaIteration() {
+    for (int node = 0; node < topology.getNodesCount(); node++) {
+        nodeFlips[node] = getNodeFlips(node);
+        nodeTimes[node] = 0;
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    topology.resetRunners();
+
+    #pragma omp parallel num_threads(threads)
+    {
+        int thread = omp_get_thread_num();
+        int node = topology.getNode(thread);
+        topology.pinThread(thread);
+
+        for (int i = topology.nextRunner(node); i >= 0; i = topology.nextRunner(node))
+            randomWalk(*runners[i]);
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0;
+
+        #pragma omp critical(flipGraphNodeTimes)
+        nodeTimes[node] = std::max(nodeTimes[node], elapsed);
+    }
+
+    for (int node = 0; node < topology.getNodesCount(); node++)
+        nodeFlips[node] = getNodeFlips(node) - nodeFlips[node];
+}
+
+template <typename Scheme>
+void FlipGraph<Scheme>::placeRunners() {
+    std::vector<std::unique_ptr<Runner>> placedRunners(count);
+    topology.resetRunners();
+
+    #pragma omp parallel num_threads(threads)
+    {
+        int thread = omp_get_thread_num();
+        int node = topology.getNode(thread);
+        topology.pinThread(thread);
+
+        for (int i = topology.nextRunner(node); i >= 0; i = topology.nextRunner(node))
+            placedRunners[i] = std::make_unique<Runner>(*runners[i]);
+    }
+
+    runners.swap(placedRunners);
+}
+
+template <typename Scheme>
+size_t FlipGraph<Scheme>::getNodeFlips(int node) const {
+    size_t total = 0;
+
+    for (int i = topology.getRunnersBegin(node); i < topology.getRunnersEnd(node); i++)
+        total += runners[i]->scheme.getCounters().flips;
+
+    return total;
+}
+
+template <typename Scheme>
+OperationCounters FlipGraph<Scheme>::getCounters() const {
+    OperationCounters total;
+
+    for (int i = 0; i < count; i++)
+        total += runners[i]->scheme.getCounters();
+
+    return total;
+}
+
+template <typename Scheme>
+void FlipGraph<Scheme>::updateCounters(double elapsed) {
+    OperationCounters total = getCounters();
+    iterationCounters = total - lastCounters;
+    lastCounters = total;
+    iterationTime = elapsed;
 }
 
 template <typename Scheme>
@@ -217,35 +567,37 @@ void FlipGraph<Scheme>::updateBest(size_t iteration) {
     });
 
     int top = indices[0];
-    if (bestRanks[top] >= bestRank)
+    if (runners[top]->bestRank >= bestRank)
         return;
 
-    if (!schemesBest[top].validateParallel()) {
+    if (!runners[top]->schemeBest.validateParallel()) {
         std::cout << "Unable to save: scheme invalid" << std::endl;
         return;
     }
 
-    std::string path = getSavePath(schemesBest[top], iteration, outputPath);
-    saveScheme(schemesBest[top], path);
-    addImprovement(schemesBest[top]);
+    std::string path = getSavePath(runners[top]->schemeBest, iteration, outputPath);
+    saveScheme(runners[top]->schemeBest, path);
+    #pragma omp critical(flipGraphImprovements)
+    addImprovement(runners[top]->schemeBest);
 
-    std::cout << "Rank was improved from " << bestRank << " to " << bestRanks[top] << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
-    bestRank = bestRanks[top];
+    std::cout << "Rank was improved from " << bestRank << " to " << runners[top]->bestRank << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
+    bestRank = runners[top]->bestRank;
 
     #pragma omp parallel for num_threads(threads)
     for (int i = 0; i < count; i++) {
-        if (uniform(generators[omp_get_thread_num()]) >= copyBestProbability || i == top)
+        if (uniform(runners[i]->generator) >= copyBestProbability || i == top)
             continue;
 
-        schemes[i].copy(schemesBest[top]);
-        schemesBest[i].copy(schemesBest[top]);
-        iterations[i] = 0;
-        flips[i] = 0;
+        runners[i]->scheme.copy(runners[top]->schemeBest);
+        runners[i]->schemeBest.copy(runners[top]->schemeBest);
+        runners[i]->iterations = 0;
+        runners[i]->flips = 0;
+        runners[i]->copiedBest = true;
     }
 }
 
 template <typename Scheme>
-void FlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes) const {
+void FlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes, std::ostream &os) const {
     double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count() / 1000.0;
 
     double lastTime = elapsedTimes[elapsedTimes.size() - 1];
@@ -253,62 +605,80 @@ void FlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolution_cl
     double maxTime = *std::max_element(elapsedTimes.begin(), elapsedTimes.end());
     double meanTime = std::accumulate(elapsedTimes.begin(), elapsedTimes.end(), 0.0) / elapsedTimes.size();
 
-    std::cout << std::left;
-    std::cout << "+-----------------------------------------------------------------------------------+" << std::endl;
-    std::cout << "| ";
-    std::cout << "dimension: " << std::setw(14) << schemes[indices[0]].getDimension() << "   ";
-    std::cout << "seed: " << std::setw(20) << seed << "   ";
-    std::cout << std::right << std::setw(24) << ("best rank: " + std::to_string(bestRank));
-    std::cout << " |" << std::endl;
-
-    std::cout << "| " << std::left;
-    std::cout << "threads: " << std::setw(16) << threads << "   ";
-    std::cout << "flip iters: " << std::setw(14) << prettyInt(flipParameters.flipIterations) << "   ";
-    std::cout << std::right << std::setw(24) << ("iteration: " + std::to_string(iteration));
-    std::cout << " |" << std::endl;
-
-    std::cout << "| " << std::left;
-    std::cout << "count: " << std::setw(18) << count << "   ";
-    std::cout << "reset iters: " << std::setw(13) << prettyInt(flipParameters.resetIterations) << "   ";
-    std::cout << std::right << std::setw(24) << ("elapsed: " + prettyTime(elapsed));
-    std::cout << " |" << std::endl;
-
-    std::cout << "| " << std::left;
-    std::cout << "ring: " << std::setw(19) << schemes[0].getRing() << "   ";
-    std::cout << "plus diff: " << std::setw(15) << flipParameters.plusDiff << "   ";
-    std::cout << std::right << std::setw(24) << ("improvements: " + std::to_string(improvements.size()) + " / " + std::to_string(maxImprovements));
-    std::cout << " |" << std::endl;
-
-    std::cout << "+===================================================================================+" << std::endl;
-    std::cout << "| runner | scheme rank |   naive    |            |        flips        |    plus    |" << std::endl;
-    std::cout << "|   id   | best | curr | complexity | iterations |  count  | available | iterations |" << std::endl;
-    std::cout << "+--------+------+------+------------+------------+---------+-----------+------------+" << std::endl;
-    std::cout << std::right;
+    os << std::left;
+    os << "+-----------------------------------------------------------------------------------+" << std::endl;
+    os << "| ";
+    os << "dimension: " << std::setw(14) << runners[indices[0]]->scheme.getDimension() << "   ";
+    os << "seed: " << std::setw(20) << seed << "   ";
+    os << std::right << std::setw(24) << ("best rank: " + std::to_string(bestRank));
+    os << " |" << std::endl;
+
+    os << "| " << std::left;
+    os << "threads: " << std::setw(16) << threads << "   ";
+    os << "flip iters: " << std::setw(14) << prettyInt(flipParameters.flipIterations) << "   ";
+    os << std::right << std::setw(24) << ("iteration: " + std::to_string(iteration));
+    os << " |" << std::endl;
+
+    os << "| " << std::left;
+    os << "count: " << std::setw(18) << count << "   ";
+    os << "reset iters: " << std::setw(13) << prettyInt(flipParameters.resetIterations) << "   ";
+    os << std::right << std::setw(24) << ("elapsed: " + prettyTime(elapsed));
+    os << " |" << std::endl;
+
+    os << "| " << std::left;
+    os << "ring: " << std::setw(19) << runners[0]->scheme.getRing() << "   ";
+    os << "plus diff: " << std::setw(15) << flipParameters.plusDiff << "   ";
+    os << std::right << std::setw(24) << ("improvements: " + std::to_string(improvements.size()) + " / " + std::to_string(maxImprovements));
+    os << " |" << std::endl;
+
+    os << "+===================================================================================+" << std::endl;
+    os << "| runner | scheme rank |   naive    |            |        flips        |    plus    |" << std::endl;
+    os << "|   id   | best | curr | complexity | iterations |  count  | available | iterations |" << std::endl;
+    os << "+--------+------+------+------------+------------+---------+-----------+------------+" << std::endl;
+    os << std::right;
 
     for (int i = 0; i < topCount; i++) {
         int runner = indices[i];
-        std::cout << "| ";
-        std::cout << std::setw(6) << runner << " | ";
-        std::cout << std::setw(4) << schemesBest[runner].getRank() << " | ";
-        std::cout << std::setw(4) << schemes[runner].getRank() << " | ";
-        std::cout << std::setw(10) << schemes[runner].getComplexity() << " | ";
-        std::cout << std::setw(10) << prettyInt(iterations[runner]) << " | ";
-        std::cout << std::setw(7) << prettyInt(flips[runner]) << " | ";
-        std::cout << std::setw(9) << schemes[runner].getAvailableFlips() << " | ";
-        std::cout << std::setw(10) << prettyInt(plusIterations[runner]) << " |";
-        std::cout << std::endl;
-    }
-
-    std::cout << "+--------+------+------+------------+------------+---------+-----------+------------+" << std::endl;
-    std::cout << "- iteration time (last / min / max / mean): " << prettyTime(lastTime) << " / " << prettyTime(minTime) << " / " << prettyTime(maxTime) << " / " << prettyTime(meanTime) << std::endl;
-    std::cout << std::endl;
+        os << "| ";
+        os << std::setw(6) << runner << " | ";
+        os << std::setw(4) << runners[runner]->schemeBest.getRank() << " | ";
+        os << std::setw(4) << runners[runner]->scheme.getRank() << " | ";
+        os << std::setw(10) << runners[runner]->scheme.getComplexity() << " | ";
+        os << std::setw(10) << prettyInt(runners[runner]->iterations) << " | ";
+        os << std::setw(7) << prettyInt(runners[runner]->flips) << " | ";
+        os << std::setw(9) << runners[runner]->scheme.getAvailableFlips() << " | ";
+        os << std::setw(10) << prettyInt(runners[runner]->plusIterations) << " |";
+        os << std::endl;
+    }
+
+    os << "+--------+------+------+------------+------------+---------+-----------+------------+" << std::endl;
+    os << "- iteration time (last / min / max / mean): " << prettyTime(lastTime) << " / " << prettyTime(minTime) << " / " << prettyTime(maxTime) << " / " << prettyTime(meanTime) << std::endl;
+
+    iterationCounters.print(os, iterationTime);
+
+    if (numa) {
+        os << "- flips per second by node:";
+
+        for (int node = 0; node < topology.getNodesCount(); node++)
+            os << (node ? ", " : " ") << topology.getNodeId(node) << ": " << prettyInt(nodeTimes[node] > 0 ? size_t(nodeFlips[node] / nodeTimes[node]) : 0);
+
+        os << std::endl;
+    }
+    os << std::endl;
 }
 
 template <typename Scheme>
-void FlipGraph<Scheme>::randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, int &bestRank, std::mt19937 &generator) {
-    plusIterations = plusDistribution(generator);
+void FlipGraph<Scheme>::randomWalk(Runner &runner) {
+    Scheme &scheme = runner.scheme;
+    Scheme &schemeBest = runner.schemeBest;
+    RandomGenerator &generator = runner.generator;
+
+    size_t flipsCount = runner.flips;
+    size_t iterationsCount = runner.iterations;
+    size_t plusIterations = plusDistribution(generator);
+    int bestRank = runner.bestRank;
 
-    for (size_t iteration = 0; iteration < flipParameters.flipIterations; iteration++) {
+    for (size_t iteration = 0; iteration < flipParameters.flipIterations && !targetReached.load(std::memory_order_relaxed) && !stopSignal; iteration++) {
         int prevRank = scheme.getRank();
 
         if (!scheme.tryFlip(generator)) {
@@ -335,6 +705,11 @@ void FlipGraph<Scheme>::randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &f
             schemeBest.copy(scheme);
             bestRank = rank;
             iterationsCount = 0;
+
+            if (rank <= targetRank) {
+                targetReached = true;
+                break;
+            }
         }
 
         if (flipsCount >= plusIterations && rank < bestRank + flipParameters.plusDiff && scheme.tryExpand(generator)) {
@@ -343,40 +718,48 @@ void FlipGraph<Scheme>::randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &f
         }
 
         if (iterationsCount >= flipParameters.resetIterations) {
-            Scheme &initial = improvements[generator() % improvements.size()];
-
-            scheme.copy(initial);
-            schemeBest.copy(initial);
-            bestRank = initial.getRank();
+            #pragma omp critical(flipGraphImprovements)
+            {
+                Scheme &initial = improvements[generator() % improvements.size()];
+                scheme.copy(initial);
+                schemeBest.copy(initial);
+            }
+
+            bestRank = schemeBest.getRank();
             flipsCount = 0;
             iterationsCount = 0;
             plusIterations = plusDistribution(generator);
         }
     }
+
+    runner.flips = flipsCount;
+    runner.iterations = iterationsCount;
+    runner.plusIterations = plusIterations;
+    runner.bestRank = bestRank;
 }
 
 template <typename Scheme>
 bool FlipGraph<Scheme>::compare(int index1, int index2) const {
-    int bestRank1 = schemesBest[index1].getRank();
-    int bestRank2 = schemesBest[index2].getRank();
+    int bestRank1 = runners[index1]->schemeBest.getRank();
+    int bestRank2 = runners[index2]->schemeBest.getRank();
 
     if (bestRank1 != bestRank2)
         return bestRank1 < bestRank2;
 
-    int bestFlips1 = schemesBest[index1].getAvailableFlips();
-    int bestFlips2 = schemesBest[index2].getAvailableFlips();
+    int bestFlips1 = runners[index1]->schemeBest.getAvailableFlips();
+    int bestFlips2 = runners[index2]->schemeBest.getAvailableFlips();
 
     if (bestFlips1 != bestFlips2)
         return bestFlips1 > bestFlips2;
 
-    int rank1 = schemes[index1].getRank();
-    int rank2 = schemes[index2].getRank();
+    int rank1 = runners[index1]->scheme.getRank();
+    int rank2 = runners[index2]->scheme.getRank();
 
     if (rank1 != rank2)
         return rank1 < rank2;
 
-    int complexity1 = schemes[index1].getComplexity();
-    int complexity2 = schemes[index2].getComplexity();
+    int complexity1 = runners[index1]->scheme.getComplexity();
+    int complexity2 = runners[index2]->scheme.getComplexity();
 
     if (complexity1 != complexity2)
         return complexity1 < complexity2;
@@ -406,6 +789,55 @@ void FlipGraph<Scheme>::saveScheme(const Scheme &scheme, const std::string &path
     }
 }
 
+template <typename Scheme>
+void FlipGraph<Scheme>::saveCheckpoint(size_t iteration) {
+    CheckpointHeader header;
+    header.ring = runners[0]->scheme.getRing();
+    header.count = count;
+
+    for (int i = 0; i < 3; i++)
+        header.dimension[i] = runners[0]->scheme.getDimension(i);
+
+    std::stringstream ss;
+    header.write(ss);
+
+    writeBinary(ss, uint64_t(iteration));
+    writeBinary(ss, bestRank);
+    writeBinary(ss, improvementsIndex);
+    writeBinary(ss, uint64_t(improvements.size()));
+
+    for (const Scheme &scheme : improvements)
+        scheme.pack(ss);
+
+    for (int i = 0; i < count; i++) {
+        runners[i]->scheme.pack(ss);
+        runners[i]->schemeBest.pack(ss);
+        runners[i]->generator.pack(ss);
+    }
+
+    std::vector<size_t> flips(count), iterations(count), plusIterations(count);
+    std::vector<int> bestRanks(count);
+
+    for (int i = 0; i < count; i++) {
+        flips[i] = runners[i]->flips;
+        iterations[i] = runners[i]->iterations;
+        plusIterations[i] = runners[i]->plusIterations;
+        bestRanks[i] = runners[i]->bestRank;
+    }
+
+    writeBinary(ss, flips);
+    writeBinary(ss, iterations);
+    writeBinary(ss, plusIterations);
+    writeBinary(ss, bestRanks);
+
+    checkpointWriter.write(checkpointParameters.path, ss.str());
+
+    if (stopSignal) {
+        checkpointWriter.wait();
+        std::cout << "Stopped by signal, checkpoint was saved to \"" << checkpointParameters.path << "\"" << std::endl;
+    }
+}
+
 template <typename Scheme>
 void FlipGraph<Scheme>::initializeMetrics() {
     if (!metricsParameters.use)
@@ -418,11 +850,12 @@ void FlipGraph<Scheme>::initializeMetrics() {
     }
 
     f << "{";
-    f << "\"dimension\": [" << schemes[0].getDimension(0) << ", " << schemes[0].getDimension(1) << ", " << schemes[0].getDimension(2) << "], ";
+    f << "\"dimension\": [" << runners[0]->scheme.getDimension(0) << ", " << runners[0]->scheme.getDimension(1) << ", " << runners[0]->scheme.getDimension(2) << "], ";
     f << "\"count\": " << count << ", ";
-    f << "\"ring\": \"" << schemes[0].getRing() << "\", ";
+    f << "\"ring\": \"" << runners[0]->scheme.getRing() << "\", ";
     f << "\"copy_best_probability\": " << copyBestProbability << ", ";
     f << "\"seed\": " << seed << ", ";
+    f << "\"random_generator\": \"" << runners[0]->generator.getType() << "\", ";
     f << "\"random_walk_parameters\": ";
     flipParameters.writeJSON(f);
     f << "}" << std::endl;
@@ -476,19 +909,20 @@ void FlipGraph<Scheme>::saveMetrics(size_t iteration) const {
     if (!metricsParameters.use)
         return;
 
-    std::ofstream f(metricsParameters.path, std::ios::app);
-    if (!f) {
-        std::cout << "Unable to open file \"" << metricsParameters.path << "\" for append metrics" << std::endl;
-        return;
-    }
+    std::stringstream ss;
+    writeMetrics(iteration, ss);
+    appendMetrics(ss.str());
+}
 
+template <typename Scheme>
+void FlipGraph<Scheme>::writeMetrics(size_t iteration, std::ostream &f) const {
     std::vector<int> ranks(count);
     std::vector<int> ranksBest(count);
 
     #pragma omp parallel for num_threads(threads)
     for (int i = 0; i < count; i++) {
-        ranks[i] = schemes[i].getRank();
-        ranksBest[i] = schemesBest[i].getRank();
+        ranks[i] = runners[i]->scheme.getRank();
+        ranksBest[i] = runners[i]->schemeBest.getRank();
     }
 
     f << "{";
@@ -497,6 +931,21 @@ void FlipGraph<Scheme>::saveMetrics(size_t iteration) const {
     evaluateMetrics(ranks, f, "ranks");
     f << ", ";
     evaluateMetrics(ranksBest, f, "ranks_best");
+    f << ", \"operations\": ";
+    iterationCounters.writeJSON(f);
+    f << ", \"flips_per_second\": " << (iterationTime > 0 ? iterationCounters.flips / iterationTime : 0);
+    f << ", \"operations_per_second\": " << (iterationTime > 0 ? iterationCounters.getOperations() / iterationTime : 0);
     f << "}" << std::endl;
+}
+
+template <typename Scheme>
+void FlipGraph<Scheme>::appendMetrics(const std::string &metrics) const {
+    std::ofstream f(metricsParameters.path, std::ios::app);
+    if (!f) {
+        std::cout << "Unable to open file \"" << metricsParameters.path << "\" for append metrics" << std::endl;
+        return;
+    }
+
+    f << metrics;
     f.close();
 }
@@ -7,17 +7,36 @@
 #include <string>
 #include <random>
 #include <vector>
-#include <unordered_set>
+#include <atomic>
 #include <omp.h>
 
 #include "utils.h"
 #include "entities/sha1.h"
+#include "entities/sharded_fingerprint_set.h"
+#include "entities/background_writer.h"
+#include "entities/weighted_sampler.h"
+#include "entities/tiered_blob_store.h"
+#include "entities/operation_counters.h"
 #include "parameters/flip_parameters.h"
 #include "parameters/pool_parameters.h"
 #include "parameters/metrics_parameters.h"
 
+const int POOL_WRITER_THREADS = 2;
+const size_t POOL_WRITER_QUEUE_SIZE = 1024;
+
 template <typename Scheme>
 class FlipGraphPool {
+    struct alignas(64) Runner {
+        Scheme scheme;
+        RandomGenerator generator;
+        size_t flips;
+        size_t iterations;
+        size_t plusIterations;
+        int rank;
+
+        Runner(const RandomGenerator &generator) : generator(generator), flips(0), iterations(0), plusIterations(0), rank(0) {}
+    };
+
     int count;
     std::string outputPath;
     int threads;
@@ -29,23 +48,34 @@ class FlipGraphPool {
     int topCount;
     std::string format;
 
-    std::vector<Scheme> initialPool;
-    std::vector<Scheme> pool;
-    std::unordered_set<std::string> hashes;
-    std::vector<Scheme> schemes;
-    std::vector<size_t> flips;
-    std::vector<size_t> iterations;
-    std::vector<size_t> plusIterations;
+    Scheme initialScheme;
+    TieredBlobStore initialPool;
+    TieredBlobStore pool;
+    TieredBlobStore nextPool;
+    std::vector<int> initialFlips;
+    std::vector<int> poolFlips;
+    std::vector<int> nextFlips;
+    ShardedFingerprintSet fingerprints;
+    ShardedFingerprintSet nextFingerprints;
+    std::vector<std::unique_ptr<Runner>> runners;
     std::vector<int> indices;
     int poolRank;
-    int poolFlips;
+    int targetRank;
+    int pipelineRunners;
+    WeightedSampler poolSampler;
+    WeightedSampler pipelineSampler;
+    std::atomic<size_t> poolFound;
+    std::atomic<size_t> nextFound;
+    OperationCounters lastCounters;
+    OperationCounters iterationCounters;
+    double iterationTime;
 
-    std::vector<std::mt19937> generators;
     std::uniform_real_distribution<double> uniform;
     std::uniform_int_distribution<size_t> plusDistribution;
     SHA1 sha1;
+    BackgroundWriter writer;
 public:
-    FlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const PoolParameters &poolParameters, const MetricsParameters &metricsParameters, int seed, int topCount, const std::string &format);
+    FlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const PoolParameters &poolParameters, const MetricsParameters &metricsParameters, int seed, const std::string &generatorType, int topCount, const std::string &format);
 
     bool initializeNaive(int n1, int n2, int n3);
     bool initializeFromFile(const std::string &path, bool multiple, bool checkCorrectness);
@@ -54,23 +84,25 @@ public:
 private:
     void initIteration();
     void runIteration();
+    OperationCounters getCounters() const;
+    void updateCounters(double elapsed);
     void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes);
+    void addSchemes(const std::vector<const Scheme*> &candidates, TieredBlobStore &store, std::vector<int> &storeFlips, ShardedFingerprintSet &storeFingerprints, int rank);
     void updatePool();
 
-    void randomWalk(Scheme &scheme, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, std::vector<Scheme> &pool, std::mt19937 &generator);
+    void randomWalk(Runner &runner, std::vector<Scheme> &discovered, bool pipeline);
 
-    std::string getPoolPath() const;
+    std::string getPoolPath(int rank) const;
     std::string getSavePath(const Scheme &scheme, int version, const std::string path) const;
-    std::string getHash(const Scheme &scheme) const;
     void saveScheme(const Scheme &scheme, const std::string &path) const;
-    size_t selectScheme(std::mt19937 &generator);
+    size_t selectScheme(RandomGenerator &generator, bool pipeline);
 
     void initializeMetrics();
     void saveMetrics(size_t iteration, size_t step) const;
 };
 
 template <typename Scheme>
-FlipGraphPool<Scheme>::FlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const PoolParameters &poolParameters, const MetricsParameters &metricsParameters, int seed, int topCount, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
+FlipGraphPool<Scheme>::FlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const PoolParameters &poolParameters, const MetricsParameters &metricsParameters, int seed, const std::string &generatorType, int topCount, const std::string &format) : initialPool(poolParameters.memorySize, poolParameters.diskPath), pool(poolParameters.memorySize, poolParameters.diskPath), nextPool(poolParameters.memorySize, poolParameters.diskPath), uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations), writer(POOL_WRITER_THREADS, POOL_WRITER_QUEUE_SIZE) {
     this->count = count;
     this->outputPath = outputPath;
     this->threads = std::min(threads, count);
@@ -80,13 +112,13 @@ FlipGraphPool<Scheme>::FlipGraphPool(int count, const std::string outputPath, in
     this->seed = seed;
     this->topCount = std::min(topCount, count);
     this->format = format;
+    this->pipelineRunners = std::min(this->count - 1, int(count * poolParameters.pipelineRatio + 0.5));
 
-    generators = initRandomGenerators(seed, threads);
+    runners = initRunners<Runner>(seed, count, generatorType, this->threads);
+
+    if (!poolParameters.diskPath.empty())
+        makeDirectory(poolParameters.diskPath);
 
-    schemes.resize(count);
-    flips.resize(count);
-    iterations.resize(count);
-    plusIterations.resize(count);
     indices.resize(count);
 
     #pragma omp parallel for num_threads(threads)
@@ -102,7 +134,12 @@ bool FlipGraphPool<Scheme>::initializeNaive(int n1, int n2, int n3) {
     if (!scheme.initializeNaive(n1, n2, n3))
         return false;
 
-    initialPool.emplace_back(scheme);
+    std::vector<uint8_t> blob;
+    scheme.packTerms(blob);
+
+    initialScheme.copy(scheme);
+    initialPool.push(blob);
+    initialFlips.push_back(scheme.getAvailableFlips());
     poolRank = n1 * n2 * n3;
 
     std::cout << "Initial pool rank set to " << poolRank << std::endl;
@@ -124,19 +161,24 @@ bool FlipGraphPool<Scheme>::initializeFromFile(const std::string &path, bool mul
 
     std::cout << "Start reading " << schemesCount << " schemes from \"" << path << "\" as initial pool" << std::endl;
 
-    initialPool.resize(schemesCount);
-
     bool valid = true;
+    std::vector<uint8_t> blob;
 
     for (int i = 0; i < schemesCount; i++) {
-        if (!initialPool[i].read(f, checkCorrectness)) {
+        Scheme scheme;
+        if (!scheme.read(f, checkCorrectness)) {
             valid = false;
             break;
         }
 
-        int schemeRank = initialPool[i].getRank();
+        scheme.packTerms(blob);
+        initialPool.push(blob);
+        initialFlips.push_back(scheme.getAvailableFlips());
+
+        int schemeRank = scheme.getRank();
 
         if (i == 0) {
+            initialScheme.copy(scheme);
             poolRank = schemeRank;
             std::cout << "Initial pool rank set to " << poolRank << std::endl;
             continue;
@@ -156,6 +198,10 @@ bool FlipGraphPool<Scheme>::initializeFromFile(const std::string &path, bool mul
 template <typename Scheme>
 void FlipGraphPool<Scheme>::run(int targetRank) {
     auto startTime = std::chrono::high_resolution_clock::now();
+    this->targetRank = targetRank;
+
+    lastCounters = getCounters();
+    iterationTime = 0;
 
     initializeMetrics();
     saveMetrics(0, 0);
@@ -173,6 +219,7 @@ void FlipGraphPool<Scheme>::run(int targetRank) {
 
             auto t1 = std::chrono::high_resolution_clock::now();
             runIteration();
+            updateCounters(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - t1).count() / 1000.0);
             saveMetrics(++iteration, step + 1);
             auto t2 = std::chrono::high_resolution_clock::now();
             elapsedTimes.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0);
@@ -182,51 +229,140 @@ void FlipGraphPool<Scheme>::run(int targetRank) {
 
         updatePool();
     }
+
+    writer.wait();
 }
 
 template <typename Scheme>
 void FlipGraphPool<Scheme>::initIteration() {
-    std::cout << "Run next iteration with pool rank " << poolRank << " (" << initialPool.size() << " schemes)" << std::endl;
+    std::cout << "Run next iteration with pool rank " << poolRank << " (" << initialPool.size() << " schemes";
+    if (pool.size())
+        std::cout << ", next rank pool already has " << pool.size() << " schemes";
+    std::cout << ")" << std::endl;
     poolRank--;
 
-    poolFlips = 0;
-    for (const auto &scheme: initialPool)
-        poolFlips += scheme.getAvailableFlips();
+    poolSampler.clear();
+    pipelineSampler.clear();
 
-    pool.clear();
-    hashes.clear();
-    iterations.assign(count, 0);
+    if (poolParameters.selectStrategy == "flips") {
+        for (int flips : initialFlips)
+            poolSampler.push(flips);
+
+        for (int flips : poolFlips)
+            pipelineSampler.push(flips);
+    }
+
+    for (int i = 0; i < count; i++)
+        runners[i]->iterations = 0;
+
+    if (!makeDirectory(getPoolPath(poolRank)))
+        exit(-1);
 
-    std::string poolPath = getPoolPath();
-    if (!makeDirectory(poolPath))
+    if (pipelineRunners > 0 && poolRank > targetRank && !makeDirectory(getPoolPath(poolRank - 1)))
         exit(-1);
 }
 
 template <typename Scheme>
 void FlipGraphPool<Scheme>::runIteration() {
     std::vector<std::vector<Scheme>> poolIteration(threads);
+    poolFound = pool.size();
+    nextFound = nextPool.size();
 
-    #pragma omp parallel for num_threads(threads)
+    bool pipelined = pipelineRunners > 0 && poolRank > targetRank && pool.size() >= poolParameters.minSize;
+    int levelRunners = pipelined ? count - pipelineRunners : count;
+
+    for (int i = 0; i < count; i++) {
+        int rank = i < levelRunners ? poolRank : poolRank - 1;
+
+        if (runners[i]->rank != rank) {
+            runners[i]->rank = rank;
+            runners[i]->iterations = 0;
+        }
+    }
+
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
     for (int i = 0; i < count; i++) {
-        int thread = omp_get_thread_num();
-        randomWalk(schemes[i], flips[i], iterations[i], plusIterations[i], poolIteration[thread], generators[thread]);
+        randomWalk(*runners[i], poolIteration[omp_get_thread_num()], i >= levelRunners);
     }
 
-    std::string path = getPoolPath();
-    for (int i = 0; i < threads; i++) {
-        for (const Scheme &scheme : poolIteration[i]) {
-            if (!poolParameters.uniqueType.empty()) {
-                std::string hash = sha1.get(getHash(scheme));
-                if (hashes.find(hash) != hashes.end())
-                    continue;
+    std::vector<const Scheme*> candidates;
+    std::vector<const Scheme*> nextCandidates;
 
-                hashes.insert(hash);
-            }
+    for (int i = 0; i < threads; i++)
+        for (const Scheme &scheme : poolIteration[i])
+            (scheme.getRank() == poolRank ? candidates : nextCandidates).push_back(&scheme);
 
-            pool.emplace_back(scheme);
-            std::string schemePath = getSavePath(scheme, pool.size(), path);
-            saveScheme(scheme, schemePath);
-        }
+    addSchemes(candidates, pool, poolFlips, fingerprints, poolRank);
+    addSchemes(nextCandidates, nextPool, nextFlips, nextFingerprints, poolRank - 1);
+
+    if (poolParameters.selectStrategy == "flips")
+        for (size_t i = pipelineSampler.size(); i < poolFlips.size(); i++)
+            pipelineSampler.push(poolFlips[i]);
+}
+
+template <typename Scheme>
+OperationCounters FlipGraphPool<Scheme>::getCounters() const {
+    OperationCounters total;
+
+    for (int i = 0; i < count; i++)
+        total += runners[i]->scheme.getCounters();
+
+    return total;
+}
+
+template <typename Scheme>
+void FlipGraphPool<Scheme>::updateCounters(double elapsed) {
+    OperationCounters total = getCounters();
+    iterationCounters = total - lastCounters;
+    lastCounters = total;
+    iterationTime = elapsed;
+}
+
+template <typename Scheme>
+void FlipGraphPool<Scheme>::addSchemes(const std::vector<const Scheme*> &candidates, TieredBlobStore &store, std::vector<int> &storeFlips, ShardedFingerprintSet &storeFingerprints, int rank) {
+    std::vector<uint8_t> unique(candidates.size(), 1);
+
+    if (!poolParameters.uniqueType.empty()) {
+        std::vector<SchemeFingerprint> candidateFingerprints(candidates.size());
+
+        #pragma omp parallel for num_threads(threads)
+        for (size_t i = 0; i < candidates.size(); i++)
+            candidateFingerprints[i] = getUniqueFingerprint(*candidates[i], poolParameters.uniqueType);
+
+        std::vector<std::vector<size_t>> shardCandidates(storeFingerprints.getShards());
+        for (size_t i = 0; i < candidates.size(); i++)
+            shardCandidates[storeFingerprints.getShard(candidateFingerprints[i])].push_back(i);
+
+        // every shard is filled by one thread in the order of candidates, so the result does not depend on the threads count
+        #pragma omp parallel for num_threads(threads) schedule(dynamic)
+        for (int shard = 0; shard < storeFingerprints.getShards(); shard++)
+            for (size_t i : shardCandidates[shard])
+                unique[i] = storeFingerprints.insertUnlocked(shard, candidateFingerprints[i]);
+    }
+
+    std::vector<size_t> added;
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (unique[i])
+            added.push_back(i);
+
+    std::vector<std::vector<uint8_t>> blobs(added.size());
+
+    #pragma omp parallel for num_threads(threads)
+    for (size_t i = 0; i < added.size(); i++)
+        candidates[added[i]]->packTerms(blobs[i]);
+
+    std::string path = getPoolPath(rank);
+    for (size_t i = 0; i < added.size(); i++) {
+        store.push(blobs[i]);
+        storeFlips.push_back(candidates[added[i]]->getAvailableFlips());
+
+        // the writer restores the scheme from its packed terms, a queued write holds a few bytes per term instead of a scheme with flips
+        int version = store.size();
+        writer.submit([this, blob = std::move(blobs[i]), version, path]() {
+            Scheme scheme;
+            if (scheme.unpackTerms(blob.data(), blob.size()))
+                saveScheme(scheme, getSavePath(scheme, version, path));
+        });
     }
 }
 
@@ -242,7 +378,7 @@ void FlipGraphPool<Scheme>::report(size_t iteration, std::chrono::high_resolutio
     std::cout << std::left;
     std::cout << "+------------------------------------------------------------------------------+" << std::endl;
     std::cout << "| ";
-    std::cout << "dimension: " << std::setw(14) << initialPool[0].getDimension() << "   ";
+    std::cout << "dimension: " << std::setw(14) << initialScheme.getDimension() << "   ";
     std::cout << "seed: " << std::setw(20) << seed << "   ";
     std::cout << std::right << std::setw(19) << ("iteration: " + std::to_string(iteration));
     std::cout << " |" << std::endl;
@@ -260,19 +396,19 @@ void FlipGraphPool<Scheme>::report(size_t iteration, std::chrono::high_resolutio
     std::cout << " |" << std::endl;
 
     std::cout << "| " << std::left;
-    std::cout << "ring: " << std::setw(19) << initialPool[0].getRing() << "   ";
+    std::cout << "ring: " << std::setw(19) << initialScheme.getRing() << "   ";
     std::cout << "plus diff: " << std::setw(15) << flipParameters.plusDiff << "   ";
     std::cout << std::right << std::setw(19) << ("pool rank: " + std::to_string(poolRank));
     std::cout << " |" << std::endl;
 
     std::partial_sort(indices.begin(), indices.begin() + topCount, indices.end(), [this](int index1, int index2) {
-        int rank1 = schemes[index1].getRank();
-        int rank2 = schemes[index2].getRank();
+        int rank1 = runners[index1]->scheme.getRank();
+        int rank2 = runners[index2]->scheme.getRank();
         if (rank1 != rank2)
             return rank1 < rank2;
 
-        int complexity1 = schemes[index1].getComplexity();
-        int complexity2 = schemes[index2].getComplexity();
+        int complexity1 = runners[index1]->scheme.getComplexity();
+        int complexity2 = runners[index2]->scheme.getComplexity();
         return complexity1 < complexity2;
     });
 
@@ -286,36 +422,64 @@ void FlipGraphPool<Scheme>::report(size_t iteration, std::chrono::high_resolutio
         int runner = indices[i];
         std::cout << "| ";
         std::cout << std::setw(6) << (runner + 1) << " | ";
-        std::cout << std::setw(6) << schemes[runner].getRank() << " | ";
-        std::cout << std::setw(10) << schemes[runner].getComplexity() << " | ";
-        std::cout << std::setw(10) << prettyInt(iterations[runner]) << " | ";
-        std::cout << std::setw(7) << prettyInt(flips[runner]) << " | ";
-        std::cout << std::setw(9) << schemes[runner].getAvailableFlips() << " | ";
-        std::cout << std::setw(10) << prettyInt(plusIterations[runner]) << " |";
+        std::cout << std::setw(6) << runners[runner]->scheme.getRank() << " | ";
+        std::cout << std::setw(10) << runners[runner]->scheme.getComplexity() << " | ";
+        std::cout << std::setw(10) << prettyInt(runners[runner]->iterations) << " | ";
+        std::cout << std::setw(7) << prettyInt(runners[runner]->flips) << " | ";
+        std::cout << std::setw(9) << runners[runner]->scheme.getAvailableFlips() << " | ";
+        std::cout << std::setw(10) << prettyInt(runners[runner]->plusIterations) << " |";
         std::cout << std::endl;
     }
 
     std::cout << "+--------+--------+------------+------------+---------+-----------+------------+" << std::endl;
     std::cout << "- iteration time (last / min / max / mean): " << prettyTime(lastTime) << " / " << prettyTime(minTime) << " / " << prettyTime(maxTime) << " / " << prettyTime(meanTime) << std::endl;
+    iterationCounters.print(std::cout, iterationTime);
+    std::cout << "- pool memory (current / next): " << prettyBytes(initialPool.memoryUsage()) << " / " << prettyBytes(pool.memoryUsage()) << std::endl;
+
+    if (!poolParameters.diskPath.empty())
+        std::cout << "- pool disk (current / next): " << prettyBytes(initialPool.diskUsage()) << " (" << initialPool.diskSize() << " schemes) / " << prettyBytes(pool.diskUsage()) << " (" << pool.diskSize() << " schemes)" << std::endl;
+
+    if (!poolParameters.uniqueType.empty())
+        std::cout << "- unique fingerprints: " << fingerprints.size() << " (capacity: " << fingerprints.capacity() << ", memory: " << prettyBytes(fingerprints.memoryUsage()) << ")" << std::endl;
+
+    if (pipelineRunners > 0 && poolRank > targetRank)
+        std::cout << "- pipeline: " << pipelineRunners << " runners on rank " << poolRank << " pool, rank " << (poolRank - 1) << " pool size: " << nextPool.size() << std::endl;
+
+    std::cout << "- pending writes: " << writer.pending() << " (queue full stalls: " << writer.getStalls() << ")" << std::endl;
+
     std::cout << std::endl;
 }
 
 template <typename Scheme>
 void FlipGraphPool<Scheme>::updatePool() {
-    initialPool.resize(pool.size());
-
-    #pragma omp parallel for num_threads(threads)
-    for (size_t i = 0; i < pool.size(); i++)
-        initialPool[i].copy(pool[i]);
+    std::swap(initialPool, pool);
+    std::swap(initialFlips, poolFlips);
+    std::swap(pool, nextPool);
+    std::swap(poolFlips, nextFlips);
+    std::swap(fingerprints, nextFingerprints);
+
+    nextPool.clear();
+    nextFlips.clear();
+    nextFingerprints.clear();
 }
 
 template <typename Scheme>
-void FlipGraphPool<Scheme>::randomWalk(Scheme &scheme, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, std::vector<Scheme> &pool, std::mt19937 &generator) {
-    size_t size = this->pool.size();
+void FlipGraphPool<Scheme>::randomWalk(Runner &runner, std::vector<Scheme> &discovered, bool pipeline) {
+    Scheme &scheme = runner.scheme;
+    RandomGenerator &generator = runner.generator;
+
+    const TieredBlobStore &source = pipeline ? pool : initialPool;
+    std::atomic<size_t> &found = pipeline ? nextFound : poolFound;
+    int targetRank = pipeline ? poolRank - 1 : poolRank;
 
-    for (size_t iteration = 0; iteration < flipParameters.flipIterations; iteration++) {
+    size_t flipsCount = runner.flips;
+    size_t iterationsCount = runner.iterations;
+    size_t plusIterations = runner.plusIterations;
+
+    for (size_t iteration = 0; iteration < flipParameters.flipIterations && found.load(std::memory_order_relaxed) < poolParameters.size; iteration++) {
         if (iterationsCount == 0 || iterationsCount >= flipParameters.resetIterations) {
-            scheme.copy(initialPool[selectScheme(generator)]);
+            size_t index = selectScheme(generator, pipeline);
+            scheme.unpackTerms(source.get(index), source.getSize(index));
             flipsCount = 0;
             iterationsCount = 0;
             plusIterations = plusDistribution(generator);
@@ -331,12 +495,12 @@ void FlipGraphPool<Scheme>::randomWalk(Scheme &scheme, size_t &flipsCount, size_
             continue;
         }
 
-        if (scheme.getRank() == poolRank) {
+        if (scheme.getRank() == targetRank) {
             Scheme poolScheme;
             poolScheme.copy(scheme);
-            pool.emplace_back(poolScheme);
+            discovered.emplace_back(poolScheme);
 
-            if (size + pool.size() >= poolParameters.size)
+            if (++found >= poolParameters.size)
                 break;
 
             iterationsCount = 0;
@@ -355,19 +519,23 @@ void FlipGraphPool<Scheme>::randomWalk(Scheme &scheme, size_t &flipsCount, size_
         if (rank < prevRank)
             flipsCount = 0;
 
-        if (flipsCount >= plusIterations && rank < poolRank + 1 + flipParameters.plusDiff && scheme.tryExpand(generator)) {
+        if (flipsCount >= plusIterations && rank < targetRank + 1 + flipParameters.plusDiff && scheme.tryExpand(generator)) {
             flipsCount = 0;
             plusIterations = plusDistribution(generator);
         }
     }
+
+    runner.flips = flipsCount;
+    runner.iterations = iterationsCount;
+    runner.plusIterations = plusIterations;
 }
 
 template <typename Scheme>
-std::string FlipGraphPool<Scheme>::getPoolPath() const {
+std::string FlipGraphPool<Scheme>::getPoolPath(int rank) const {
     std::stringstream ss;
     ss << outputPath;
-    ss << "/" << initialPool[0].getDimension();
-    ss << "/rank" + std::to_string(poolRank);
+    ss << "/" << initialScheme.getDimension();
+    ss << "/rank" + std::to_string(rank);
     return ss.str();
 }
 
@@ -382,17 +550,6 @@ std::string FlipGraphPool<Scheme>::getSavePath(const Scheme &scheme, int version
     return ss.str();
 }
 
-template <typename Scheme>
-std::string FlipGraphPool<Scheme>::getHash(const Scheme &scheme) const {
-    if (poolParameters.uniqueType == "structure")
-        return scheme.getStructureHash();
-
-    if (poolParameters.uniqueType == "type")
-        return scheme.getTypeInvariant();
-
-    return scheme.getHash();
-}
-
 template <typename Scheme>
 void FlipGraphPool<Scheme>::saveScheme(const Scheme &scheme, const std::string &path) const {
     if (format == "json") {
@@ -404,19 +561,13 @@ void FlipGraphPool<Scheme>::saveScheme(const Scheme &scheme, const std::string &
 }
 
 template <typename Scheme>
-size_t FlipGraphPool<Scheme>::selectScheme(std::mt19937 &generator) {
-    if (poolParameters.selectStrategy == "flips") {
-        int value = uniform(generator) * poolFlips;
-        int sum = 0;
+size_t FlipGraphPool<Scheme>::selectScheme(RandomGenerator &generator, bool pipeline) {
+    const WeightedSampler &sampler = pipeline ? pipelineSampler : poolSampler;
 
-        for (size_t i = 0; i < initialPool.size(); i++) {
-            sum += initialPool[i].getAvailableFlips();
-            if (sum >= value)
-                return i;
-        }
-    }
+    if (poolParameters.selectStrategy == "flips" && sampler.total() > 0)
+        return sampler.sample(size_t(uniform(generator) * sampler.total()));
 
-    return generator() % initialPool.size();
+    return generator() % (pipeline ? pool.size() : initialPool.size());
 }
 
 template <typename Scheme>
@@ -431,9 +582,9 @@ void FlipGraphPool<Scheme>::initializeMetrics() {
     }
 
     f << "{";
-    f << "\"dimension\": [" << initialPool[0].getDimension(0) << ", " << initialPool[0].getDimension(1) << ", " << initialPool[0].getDimension(2) << "], ";
+    f << "\"dimension\": [" << initialScheme.getDimension(0) << ", " << initialScheme.getDimension(1) << ", " << initialScheme.getDimension(2) << "], ";
     f << "\"count\": " << count << ", ";
-    f << "\"ring\": \"" << initialPool[0].getRing() << "\", ";
+    f << "\"ring\": \"" << initialScheme.getRing() << "\", ";
     f << "\"seed\": " << seed << ", ";
     f << "\"random_walk_parameters\": ";
     flipParameters.writeJSON(f);
@@ -458,7 +609,11 @@ void FlipGraphPool<Scheme>::saveMetrics(size_t iteration, size_t step) const {
     f << "\"iteration\": " << iteration << ", ";
     f << "\"rank\": " << poolRank << ", ";
     f << "\"pool_size\": " << (iteration == 0 ? initialPool.size() : pool.size()) << ", ";
-    f << "\"step\": " << step;
+    f << "\"step\": " << step << ", ";
+    f << "\"operations\": ";
+    iterationCounters.writeJSON(f);
+    f << ", \"flips_per_second\": " << (iterationTime > 0 ? iterationCounters.flips / iterationTime : 0);
+    f << ", \"operations_per_second\": " << (iterationTime > 0 ? iterationCounters.getOperations() / iterationTime : 0);
     f << "}" << std::endl;
     f.close();
 }
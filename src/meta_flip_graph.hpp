@@ -17,6 +17,18 @@
 
 template <typename Scheme>
 class MetaFlipGraph {
+    struct alignas(64) Runner {
+        Scheme scheme;
+        Scheme schemeBest;
+        RandomGenerator generator;
+        size_t flips;
+        size_t iterations;
+        size_t plusIterations;
+        int bestRank;
+
+        Runner(const RandomGenerator &generator) : generator(generator), flips(0), iterations(0), plusIterations(0), bestRank(0) {}
+    };
+
     size_t count;
     std::string outputPath;
     int threads;
@@ -26,14 +38,8 @@ class MetaFlipGraph {
     size_t topCount;
     std::string format;
 
-    std::vector<Scheme> schemes;
-    std::vector<Scheme> schemesBest;
-    std::vector<size_t> flips;
-    std::vector<size_t> iterations;
-    std::vector<size_t> plusIterations;
-    std::vector<int> bestRanks;
+    std::vector<std::unique_ptr<Runner>> runners;
 
-    std::vector<std::mt19937> generators;
     std::uniform_real_distribution<double> uniform;
     std::uniform_int_distribution<size_t> plusDistribution;
 
@@ -44,7 +50,7 @@ class MetaFlipGraph {
     std::vector<std::string> dimensionsInitial;
     std::vector<std::string> dimensions;
 public:
-    MetaFlipGraph(size_t count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaParameters &metaParameters, int seed, size_t topCount, const std::string &format);
+    MetaFlipGraph(size_t count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaParameters &metaParameters, int seed, const std::string &generatorType, size_t topCount, const std::string &format);
 
     bool initializeNaive(int n1, int n2, int n3);
     bool initializeFromFile(const std::string &path, bool multiple, bool checkCorrectness);
@@ -59,12 +65,12 @@ private:
     void updateBest(size_t iteration);
     void updateRanks(int iteration, bool save);
     void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes) const;
-    void randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, int &bestRank, std::mt19937 &generator);
-    void meta(Scheme &scheme, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, std::mt19937 &generator);
+    void randomWalk(Runner &runner);
+    void meta(Runner &runner);
 
-    bool metaDefault(Scheme &scheme, std::mt19937 &generator);
-    bool metaProjections(Scheme &scheme, std::mt19937 &generator);
-    bool metaExtensions(Scheme &scheme, std::mt19937 &generator);
+    bool metaDefault(Scheme &scheme, RandomGenerator &generator);
+    bool metaProjections(Scheme &scheme, RandomGenerator &generator);
+    bool metaExtensions(Scheme &scheme, RandomGenerator &generator);
 
     void updateIndices();
     bool compare(int index1, int index2) const;
@@ -72,11 +78,11 @@ private:
     std::string sortedDimension(const Scheme &scheme) const;
 
     void saveScheme(const Scheme &scheme, const std::string &path) const;
-    bool resetToNormalScheme(Scheme &scheme, std::mt19937 &generator);
+    bool resetToNormalScheme(Scheme &scheme, RandomGenerator &generator);
 };
 
 template <typename Scheme>
-MetaFlipGraph<Scheme>::MetaFlipGraph(size_t count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaParameters &metaParameters, int seed, size_t topCount, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
+MetaFlipGraph<Scheme>::MetaFlipGraph(size_t count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaParameters &metaParameters, int seed, const std::string &generatorType, size_t topCount, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
     this->count = count;
     this->outputPath = outputPath;
     this->threads = std::min(threads, (int) count);
@@ -88,30 +94,23 @@ MetaFlipGraph<Scheme>::MetaFlipGraph(size_t count, const std::string outputPath,
     this->topCount = std::min(topCount, count);
     this->format = format;
 
-    generators = initRandomGenerators(seed, threads);
-
-    schemes.resize(count);
-    schemesBest.resize(count);
-    bestRanks.resize(count);
-    flips.resize(count);
-    iterations.resize(count);
-    plusIterations.resize(count);
+    runners = initRunners<Runner>(seed, count, generatorType, this->threads);
 }
 
 template <typename Scheme>
 bool MetaFlipGraph<Scheme>::initializeNaive(int n1, int n2, int n3) {
     std::cout << "Start initializing with naive " << n1 << "x" << n2 << "x" << n3 << " schemes" << std::endl;
 
-    if (!schemes[0].initializeNaive(n1, n2, n3))
+    if (!runners[0]->scheme.initializeNaive(n1, n2, n3))
         return false;
 
     #pragma omp parallel for num_threads(threads)
     for (size_t i = 1; i < count; i++)
-        schemes[i].initializeNaive(n1, n2, n3);
+        runners[i]->scheme.initializeNaive(n1, n2, n3);
 
-    std::string dimension = sortedDimension(schemes[0]);
+    std::string dimension = sortedDimension(runners[0]->scheme);
     dimension2improvements.clear();
-    dimension2improvements[dimension].push_back(Scheme(schemes[0]));
+    dimension2improvements[dimension].push_back(Scheme(runners[0]->scheme));
     dimensionsInitial.push_back(dimension);
     return true;
 }
@@ -133,7 +132,7 @@ bool MetaFlipGraph<Scheme>::initializeFromFile(const std::string &path, bool mul
     std::cout << "Start reading " << std::min(count, schemesCount) << " / " << schemesCount << " schemes from \"" << path << "\"" << std::endl;
 
     for (size_t i = 0; i < count && i < schemesCount && valid; i++) {
-        valid = schemes[i].read(f, checkCorrectness);
+        valid = runners[i]->scheme.read(f, checkCorrectness);
 
         if (!valid)
             std::cout << "error: invalid scheme " << (i + 1) << " in the file \"" << path << "\"" << std::endl;
@@ -148,11 +147,11 @@ bool MetaFlipGraph<Scheme>::initializeFromFile(const std::string &path, bool mul
     dimensionsInitial.clear();
 
     for (size_t i = 0; i < count && i < schemesCount; i++) {
-        std::string dimension = sortedDimension(schemes[i]);
-        dimension2improvements[dimension].push_back(Scheme(schemes[i]));
+        std::string dimension = sortedDimension(runners[i]->scheme);
+        dimension2improvements[dimension].push_back(Scheme(runners[i]->scheme));
 
-        if (dimension2knownRank.find(dimension) == dimension2knownRank.end() || schemes[i].getRank() < dimension2knownRank.at(dimension))
-            dimension2knownRank[dimension] = schemes[i].getRank();
+        if (dimension2knownRank.find(dimension) == dimension2knownRank.end() || runners[i]->scheme.getRank() < dimension2knownRank.at(dimension))
+            dimension2knownRank[dimension] = runners[i]->scheme.getRank();
     }
 
     for (auto &pair : dimension2improvements) {
@@ -162,7 +161,7 @@ bool MetaFlipGraph<Scheme>::initializeFromFile(const std::string &path, bool mul
 
     #pragma omp parallel for num_threads(threads)
     for (size_t i = schemesCount; i < count; i++)
-        schemes[i].copy(schemes[i % schemesCount]);
+        runners[i]->scheme.copy(runners[i % schemesCount]->scheme);
 
     return true;
 }
@@ -201,15 +200,15 @@ template <typename Scheme>
 void MetaFlipGraph<Scheme>::initialize() {
     #pragma omp parallel for num_threads(threads)
     for (size_t i = 0; i < count; i++) {
-        int rank = schemes[i].getRank();
+        int rank = runners[i]->scheme.getRank();
 
-        schemesBest[i].copy(schemes[i]);
-        bestRanks[i] = rank;
-        flips[i] = 0;
-        iterations[i] = 0;
-        plusIterations[i] = plusDistribution(generators[omp_get_thread_num()]);
+        runners[i]->schemeBest.copy(runners[i]->scheme);
+        runners[i]->bestRank = rank;
+        runners[i]->flips = 0;
+        runners[i]->iterations = 0;
+        runners[i]->plusIterations = plusDistribution(runners[i]->generator);
 
-        dimension2bestRank[sortedDimension(schemes[i])] = rank;
+        dimension2bestRank[sortedDimension(runners[i]->scheme)] = rank;
     }
 
     updateRanks(0, false);
@@ -217,16 +216,16 @@ void MetaFlipGraph<Scheme>::initialize() {
 
 template <typename Scheme>
 void MetaFlipGraph<Scheme>::flipIteration()  {
-    #pragma omp parallel for num_threads(threads)
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
     for (size_t i = 0; i < count; i++)
-        randomWalk(schemes[i], schemesBest[i], flips[i], iterations[i], plusIterations[i], bestRanks[i], generators[omp_get_thread_num()]);
+        randomWalk(*runners[i]);
 }
 
 template <typename Scheme>
 void MetaFlipGraph<Scheme>::metaIteration() {
-    #pragma omp parallel for num_threads(threads)
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
     for (size_t i = 0; i < count; i++)
-        meta(schemes[i], flips[i], iterations[i], plusIterations[i], generators[omp_get_thread_num()]);
+        meta(*runners[i]);
 }
 
 template <typename Scheme>
@@ -237,24 +236,24 @@ void MetaFlipGraph<Scheme>::updateBest(size_t iteration) {
         int top = pair.second[0];
         int bestRank = dimension2bestRank[pair.first];
 
-        if (bestRanks[top] >= bestRank)
+        if (runners[top]->bestRank >= bestRank)
             continue;
 
         auto known = dimension2knownRank.find(pair.first);
-        if (known != dimension2knownRank.end() && bestRanks[top] >= known->second)
+        if (known != dimension2knownRank.end() && runners[top]->bestRank >= known->second)
             continue;
 
-        if (!schemesBest[top].validateParallel()) {
-            std::cout << "error: unable to save scheme " << schemesBest[top].getDimension() << " - it is invalid" << std::endl;
+        if (!runners[top]->schemeBest.validateParallel()) {
+            std::cout << "error: unable to save scheme " << runners[top]->schemeBest.getDimension() << " - it is invalid" << std::endl;
             exit(-1);
         }
 
-        std::string path = getSavePath(schemesBest[top], iteration, outputPath);
-        saveScheme(schemesBest[top], path);
-        dimension2improvements[pair.first].push_back(Scheme(schemesBest[top]));
+        std::string path = getSavePath(runners[top]->schemeBest, iteration, outputPath);
+        saveScheme(runners[top]->schemeBest, path);
+        dimension2improvements[pair.first].push_back(Scheme(runners[top]->schemeBest));
 
-        std::cout << "Rank of " << pair.first << " was improved from " << bestRank << " to " << bestRanks[top] << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
-        dimension2bestRank[pair.first] = bestRanks[top];
+        std::cout << "Rank of " << pair.first << " was improved from " << bestRank << " to " << runners[top]->bestRank << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
+        dimension2bestRank[pair.first] = runners[top]->bestRank;
     }
 }
 
@@ -264,8 +263,8 @@ void MetaFlipGraph<Scheme>::updateRanks(int iteration, bool save) {
     std::unordered_map<std::string, int> dimension2bestIndex;
 
     for (size_t i = 0; i < count; i++) {
-        std::string dimension = sortedDimension(schemes[i]);
-        int rank = schemes[i].getRank();
+        std::string dimension = sortedDimension(runners[i]->scheme);
+        int rank = runners[i]->scheme.getRank();
         newDimensions[i] = dimension;
 
         auto result = dimension2bestRank.find(dimension);
@@ -274,33 +273,33 @@ void MetaFlipGraph<Scheme>::updateRanks(int iteration, bool save) {
             dimension2bestIndex[dimension] = i;
         }
 
-        if (sortedDimension(schemesBest[i]) != dimension)
-            schemesBest[i].copy(schemes[i]);
+        if (sortedDimension(runners[i]->schemeBest) != dimension)
+            runners[i]->schemeBest.copy(runners[i]->scheme);
     }
 
     #pragma omp parallel for num_threads(threads)
     for (size_t i = 0; i < count; i++)
-        bestRanks[i] = dimension2bestRank[newDimensions[i]];
+        runners[i]->bestRank = dimension2bestRank[newDimensions[i]];
 
     for (const auto &pair : dimension2bestIndex) {
         if (dimension2improvements.find(pair.first) == dimension2improvements.end())
-            dimension2improvements[pair.first].push_back(Scheme(schemes[pair.second]));
+            dimension2improvements[pair.first].push_back(Scheme(runners[pair.second]->scheme));
 
         if (!save)
             continue;
 
         auto known = dimension2knownRank.find(pair.first);
-        if (known != dimension2knownRank.end() && bestRanks[pair.second] >= known->second)
+        if (known != dimension2knownRank.end() && runners[pair.second]->bestRank >= known->second)
             continue;
 
-        if (!schemes[pair.second].validateParallel()) {
-            std::cout << "error: unable to save scheme " << schemes[pair.second].getDimension() << " - it is invalid" << std::endl;
+        if (!runners[pair.second]->scheme.validateParallel()) {
+            std::cout << "error: unable to save scheme " << runners[pair.second]->scheme.getDimension() << " - it is invalid" << std::endl;
             exit(-1);
         }
 
-        std::string path = getSavePath(schemes[pair.second], iteration, outputPath);
-        saveScheme(schemes[pair.second], path);
-        std::cout << "Rank of " << pair.first << " was improved to " << bestRanks[pair.second] << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
+        std::string path = getSavePath(runners[pair.second]->scheme, iteration, outputPath);
+        saveScheme(runners[pair.second]->scheme, path);
+        std::cout << "Rank of " << pair.first << " was improved to " << runners[pair.second]->bestRank << ", scheme was saved to \"" << path << "." << format << "\"" << std::endl;
     }
 }
 
@@ -315,7 +314,7 @@ void MetaFlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolutio
 
     std::cout << "+---------------------------------------------------------------------------------------------------------+" << std::endl;
     std::cout << "| " << std::left;
-    std::cout << "ring: " << std::setw(21) << schemes[0].getRing() << "   ";
+    std::cout << "ring: " << std::setw(21) << runners[0]->scheme.getRing() << "   ";
     std::cout << "count: " << std::setw(20) << count << "   ";
     std::cout << std::right << std::setw(43) << ("iteration: " + std::to_string(iteration));
     std::cout << " |" << std::endl;
@@ -367,14 +366,14 @@ void MetaFlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolutio
             std::cout << "| ";
             std::cout << std::setw(6) << runner << " | ";
             std::cout << std::setw(8) << dimension << " | ";
-            std::cout << std::setw(8) << schemes[runner].getDimension() << " | ";
-            std::cout << std::setw(4) << bestRanks[runner] << " | ";
-            std::cout << std::setw(4) << schemes[runner].getRank() << " | ";
-            std::cout << std::setw(10) << schemes[runner].getComplexity() << " | ";
-            std::cout << std::setw(10) << prettyInt(iterations[runner]) << " | ";
-            std::cout << std::setw(7) << prettyInt(flips[runner]) << " | ";
-            std::cout << std::setw(9) << schemes[runner].getAvailableFlips() << " | ";
-            std::cout << std::setw(10) << prettyInt(plusIterations[runner]) << " |";
+            std::cout << std::setw(8) << runners[runner]->scheme.getDimension() << " | ";
+            std::cout << std::setw(4) << runners[runner]->bestRank << " | ";
+            std::cout << std::setw(4) << runners[runner]->scheme.getRank() << " | ";
+            std::cout << std::setw(10) << runners[runner]->scheme.getComplexity() << " | ";
+            std::cout << std::setw(10) << prettyInt(runners[runner]->iterations) << " | ";
+            std::cout << std::setw(7) << prettyInt(runners[runner]->flips) << " | ";
+            std::cout << std::setw(9) << runners[runner]->scheme.getAvailableFlips() << " | ";
+            std::cout << std::setw(10) << prettyInt(runners[runner]->plusIterations) << " |";
             std::cout << std::endl;
         }
 
@@ -386,8 +385,15 @@ void MetaFlipGraph<Scheme>::report(size_t iteration, std::chrono::high_resolutio
 }
 
 template <typename Scheme>
-void MetaFlipGraph<Scheme>::randomWalk(Scheme &scheme, Scheme &schemeBest, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, int &bestRank, std::mt19937 &generator) {
-    plusIterations = plusDistribution(generator);
+void MetaFlipGraph<Scheme>::randomWalk(Runner &runner) {
+    Scheme &scheme = runner.scheme;
+    Scheme &schemeBest = runner.schemeBest;
+    RandomGenerator &generator = runner.generator;
+
+    size_t flipsCount = runner.flips;
+    size_t iterationsCount = runner.iterations;
+    size_t plusIterations = plusDistribution(generator);
+    int bestRank = runner.bestRank;
 
     for (size_t iteration = 0; iteration < flipParameters.flipIterations; iteration++) {
         int prevRank = scheme.getRank();
@@ -433,10 +439,18 @@ void MetaFlipGraph<Scheme>::randomWalk(Scheme &scheme, Scheme &schemeBest, size_
             plusIterations = plusDistribution(generator);
         }
     }
+
+    runner.flips = flipsCount;
+    runner.iterations = iterationsCount;
+    runner.plusIterations = plusIterations;
+    runner.bestRank = bestRank;
 }
 
 template <typename Scheme>
-void MetaFlipGraph<Scheme>::meta(Scheme &scheme, size_t &flipsCount, size_t &iterationsCount, size_t &plusIterations, std::mt19937 &generator) {
+void MetaFlipGraph<Scheme>::meta(Runner &runner) {
+    Scheme &scheme = runner.scheme;
+    RandomGenerator &generator = runner.generator;
+
     if (uniform(generator) > metaParameters.probability)
         return;
 
@@ -455,21 +469,21 @@ void MetaFlipGraph<Scheme>::meta(Scheme &scheme, size_t &flipsCount, size_t &ite
     if (!resized)
         return;
 
-    flipsCount = 0;
-    iterationsCount = 0;
-    plusIterations = plusDistribution(generator);
+    runner.flips = 0;
+    runner.iterations = 0;
+    runner.plusIterations = plusDistribution(generator);
 }
 
 template <typename Scheme>
-bool MetaFlipGraph<Scheme>::metaDefault(Scheme &scheme, std::mt19937 &generator) {
+bool MetaFlipGraph<Scheme>::metaDefault(Scheme &scheme, RandomGenerator &generator) {
     bool reset = resetToNormalScheme(scheme, generator);
 
     if (uniform(generator) < 0.5)
         scheme.swapSizes(generator);
 
-    int index = generator() % schemesBest.size();
+    int index = generator() % runners.size();
 
-    if (scheme.tryMerge(schemesBest[index], generator, metaParameters.maxDimension, metaParameters.maxRank))
+    if (scheme.tryMerge(runners[index]->schemeBest, generator, metaParameters.maxDimension, metaParameters.maxRank))
         return true;
 
     if (uniform(generator) < 0.5)
@@ -479,13 +493,13 @@ bool MetaFlipGraph<Scheme>::metaDefault(Scheme &scheme, std::mt19937 &generator)
 }
 
 template <typename Scheme>
-bool MetaFlipGraph<Scheme>::metaProjections(Scheme &scheme, std::mt19937 &generator) {
+bool MetaFlipGraph<Scheme>::metaProjections(Scheme &scheme, RandomGenerator &generator) {
     bool reset = resetToNormalScheme(scheme, generator);
     return scheme.tryProject(generator, metaParameters.minDimension) || reset;
 }
 
 template <typename Scheme>
-bool MetaFlipGraph<Scheme>::metaExtensions(Scheme &scheme, std::mt19937 &generator) {
+bool MetaFlipGraph<Scheme>::metaExtensions(Scheme &scheme, RandomGenerator &generator) {
     bool reset = resetToNormalScheme(scheme, generator);
     return scheme.tryExtend(generator, metaParameters.maxDimension, metaParameters.maxRank) || reset;
 }
@@ -496,7 +510,7 @@ void MetaFlipGraph<Scheme>::updateIndices() {
     dimensions.clear();
 
     for (size_t i = 0; i < count; i++)
-        dimension2indices[sortedDimension(schemes[i])].push_back(i);
+        dimension2indices[sortedDimension(runners[i]->scheme)].push_back(i);
 
     for (auto &pair : dimension2indices) {
         size_t partialCount = std::min(topCount, pair.second.size());
@@ -509,8 +523,8 @@ void MetaFlipGraph<Scheme>::updateIndices() {
         dimensions.push_back(pair.first);
 
     std::sort(dimensions.begin(), dimensions.end(), [this](std::string &dimension1, std::string &dimension2) {
-        const Scheme &scheme1 = schemes[dimension2indices.at(dimension1)[0]];
-        const Scheme &scheme2 = schemes[dimension2indices.at(dimension2)[0]];
+        const Scheme &scheme1 = runners[dimension2indices.at(dimension1)[0]]->scheme;
+        const Scheme &scheme2 = runners[dimension2indices.at(dimension2)[0]]->scheme;
         int dimensions1[3];
         int dimensions2[3];
 
@@ -532,20 +546,20 @@ void MetaFlipGraph<Scheme>::updateIndices() {
 
 template <typename Scheme>
 bool MetaFlipGraph<Scheme>::compare(int index1, int index2) const {
-    int bestRank1 = bestRanks[index1];
-    int bestRank2 = bestRanks[index2];
+    int bestRank1 = runners[index1]->bestRank;
+    int bestRank2 = runners[index2]->bestRank;
 
     if (bestRank1 != bestRank2)
         return bestRank1 < bestRank2;
 
-    int rank1 = schemes[index1].getRank();
-    int rank2 = schemes[index2].getRank();
+    int rank1 = runners[index1]->scheme.getRank();
+    int rank2 = runners[index2]->scheme.getRank();
 
     if (rank1 != rank2)
         return rank1 < rank2;
 
-    int complexity1 = schemes[index1].getComplexity();
-    int complexity2 = schemes[index2].getComplexity();
+    int complexity1 = runners[index1]->scheme.getComplexity();
+    int complexity2 = runners[index2]->scheme.getComplexity();
 
     if (complexity1 != complexity2)
         return complexity1 < complexity2;
@@ -587,7 +601,7 @@ void MetaFlipGraph<Scheme>::saveScheme(const Scheme &scheme, const std::string &
 }
 
 template <typename Scheme>
-bool MetaFlipGraph<Scheme>::resetToNormalScheme(Scheme &scheme, std::mt19937 &generator) {
+bool MetaFlipGraph<Scheme>::resetToNormalScheme(Scheme &scheme, RandomGenerator &generator) {
     auto rank = dimension2knownRank.find(sortedDimension(scheme));
 
     if (rank == dimension2knownRank.end() || scheme.getRank() > rank->second + metaParameters.maxRankDiff) {
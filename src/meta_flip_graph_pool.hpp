@@ -14,18 +14,34 @@
 #include "utils.h"
 #include "known_ranks.h"
 #include "entities/schemes_rank_pool.hpp"
+#include "entities/pool_snapshot.h"
+#include "entities/checkpoint.h"
+#include "entities/operation_counters.h"
 #include "parameters/flip_parameters.h"
 #include "parameters/meta_pool_parameters.h"
 #include "parameters/meta_parameters.h"
+#include "parameters/metrics_parameters.h"
 
 template <typename Scheme>
 class MetaFlipGraphPool {
+    struct alignas(64) Runner {
+        Scheme scheme;
+        RandomGenerator generator;
+        size_t flips;
+        size_t iterations;
+        size_t plusIterations;
+        int rank;
+
+        Runner(const RandomGenerator &generator) : generator(generator), flips(0), iterations(0), plusIterations(0), rank(0) {}
+    };
+
     int count;
     std::string outputPath;
     int threads;
     FlipParameters flipParameters;
     MetaPoolParameters poolParameters;
     MetaParameters metaParameters;
+    MetricsParameters metricsParameters;
     int seed;
     std::string format;
 
@@ -34,17 +50,16 @@ class MetaFlipGraphPool {
     std::unordered_map<std::string, int> dimension2knownRank;
     std::unordered_map<std::string, double> dimension2priority;
 
-    std::vector<Scheme> schemes;
-    std::vector<int> ranks;
-    std::vector<size_t> flips;
-    std::vector<size_t> iterations;
-    std::vector<size_t> plusIterations;
+    std::vector<std::unique_ptr<Runner>> runners;
+    OperationCounters lastCounters;
+    OperationCounters iterationCounters;
+    double iterationTime;
 
-    std::vector<std::mt19937> generators;
     std::uniform_real_distribution<double> uniform;
     std::uniform_int_distribution<size_t> plusDistribution;
+    CheckpointWriter snapshotWriter;
 public:
-    MetaFlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaPoolParameters &poolParameters, const MetaParameters &metaParameters, int seed, const std::string &format);
+    MetaFlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaPoolParameters &poolParameters, const MetaParameters &metaParameters, const MetricsParameters &metricsParameters, int seed, const std::string &generatorType, const std::string &format);
 
     bool initializeNaive(int n1, int n2, int n3);
     bool initializeFromFile(const std::string &path, bool multiple, bool checkCorrectness);
@@ -53,28 +68,38 @@ public:
     void run();
 private:
     bool resume();
+    bool resumeSnapshot(const std::string &path, int64_t &watermark);
+    void saveSnapshot();
+    std::string getSnapshotPath() const;
+    PoolSnapshotHeader getSnapshotHeader() const;
     void runIteration();
+    OperationCounters getCounters() const;
+    void updateCounters(double elapsed);
 
-    void randomWalk(Scheme &scheme, size_t &flipsCount, int &runnerRank, size_t &iterationsCount, size_t &plusIterations, std::vector<Scheme> &pool, std::mt19937 &generator);
+    void randomWalk(Runner &runner, std::vector<Scheme> &pool);
     void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes) const;
     void showImprovements() const;
+    void initializeMetrics() const;
+    void saveMetrics(size_t iteration) const;
 
     void readPriorities();
-    void selectRunner(Scheme &scheme, std::mt19937 &generator);
-    std::string selectDimension(std::mt19937 &generator);
+    void selectRunner(Scheme &scheme, RandomGenerator &generator);
+    std::string selectDimension(RandomGenerator &generator);
+    SchemesRankPool<Scheme>& getPools(const std::string &dimension);
     void addScheme(const Scheme &scheme, bool save);
-    void metaScheme(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator);
+    void addSchemes(const std::vector<std::vector<Scheme>> &pool);
+    void metaScheme(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator);
 
-    void tryExtend(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator);
-    void tryProject(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator);
-    void tryProduct(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator);
-    void tryMerge(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator);
+    void tryExtend(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator);
+    void tryProject(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator);
+    void tryProduct(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator);
+    void tryMerge(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator);
 
     bool compareDimension(const std::string &d1, const std::string &d2) const;
 };
 
 template <typename Scheme>
-MetaFlipGraphPool<Scheme>::MetaFlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaPoolParameters &poolParameters, const MetaParameters &metaParameters, int seed, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
+MetaFlipGraphPool<Scheme>::MetaFlipGraphPool(int count, const std::string outputPath, int threads, const FlipParameters &flipParameters, const MetaPoolParameters &poolParameters, const MetaParameters &metaParameters, const MetricsParameters &metricsParameters, int seed, const std::string &generatorType, const std::string &format) : uniform(0.0, 1.0), plusDistribution(flipParameters.minPlusIterations, flipParameters.maxPlusIterations) {
     this->count = count;
     this->outputPath = outputPath;
     this->threads = std::min(threads, count);
@@ -82,17 +107,12 @@ MetaFlipGraphPool<Scheme>::MetaFlipGraphPool(int count, const std::string output
     this->flipParameters = flipParameters;
     this->poolParameters = poolParameters;
     this->metaParameters = metaParameters;
+    this->metricsParameters = metricsParameters;
 
     this->seed = seed;
     this->format = format;
 
-    generators = initRandomGenerators(seed, threads);
-
-    schemes.resize(count);
-    flips.resize(count);
-    ranks.resize(count);
-    iterations.resize(count);
-    plusIterations.resize(count);
+    runners = initRunners<Runner>(seed, count, generatorType, this->threads);
 }
 
 template <typename Scheme>
@@ -162,21 +182,48 @@ void MetaFlipGraphPool<Scheme>::initializeKnownRanks(const std::string &ring) {
 
 template <typename Scheme>
 void MetaFlipGraphPool<Scheme>::run() {
+    if (!poolParameters.diskPath.empty() && !makeDirectory(poolParameters.diskPath))
+        return;
+
     if (poolParameters.resume && !resume())
         return;
 
-    iterations.assign(count, 0);
+    for (int i = 0; i < count; i++)
+        runners[i]->iterations = 0;
+
+    if (poolParameters.snapshotInterval)
+        handleStopSignals();
 
     auto startTime = std::chrono::high_resolution_clock::now();
+    auto snapshotTime = startTime;
     std::vector<double> elapsedTimes;
+    lastCounters = getCounters();
+    iterationTime = 0;
+
+    initializeMetrics();
+    saveMetrics(0);
 
     for (size_t iteration = 0; 1; iteration++) {
         auto t1 = std::chrono::high_resolution_clock::now();
         runIteration();
         auto t2 = std::chrono::high_resolution_clock::now();
+        updateCounters(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0);
         elapsedTimes.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count() / 1000.0);
 
         report(iteration + 1, startTime, elapsedTimes);
+        saveMetrics(iteration + 1);
+
+        if (stopSignal) {
+            saveSnapshot();
+            snapshotWriter.wait();
+            std::cout << "Stopped by signal, pool snapshot was saved to \"" << getSnapshotPath() << "\"" << std::endl;
+            break;
+        }
+
+        if (poolParameters.snapshotInterval && std::chrono::duration_cast<std::chrono::seconds>(t2 - snapshotTime).count() >= poolParameters.snapshotInterval) {
+            saveSnapshot();
+            snapshotTime = t2;
+        }
     }
 }
 
@@ -187,10 +234,31 @@ bool MetaFlipGraphPool<Scheme>::resume() {
         return true;
     }
 
+    std::string snapshotPath = getSnapshotPath();
+    bool snapshotResumed = false;
+    int64_t watermark = 0;
+
+    if (std::filesystem::exists(snapshotPath)) {
+        snapshotResumed = resumeSnapshot(snapshotPath, watermark);
+
+        if (!snapshotResumed)
+            std::cout << "Unable to resume from pool snapshot, fall back to reading scheme files" << std::endl;
+    }
+
+    // schemes saved after the last snapshot are read from files, the few of them that are also in the snapshot are rejected by the unique check
     std::vector<std::string> paths;
-    for (auto it = std::filesystem::recursive_directory_iterator(outputPath); it != std::filesystem::recursive_directory_iterator(); it++)
-        if (it->is_regular_file())
-            paths.push_back(it->path().string());
+    for (auto it = std::filesystem::recursive_directory_iterator(outputPath); it != std::filesystem::recursive_directory_iterator(); it++) {
+        if (!it->is_regular_file() || (it->path().extension() != ".txt" && it->path().extension() != ".json"))
+            continue;
+
+        if (snapshotResumed && it->last_write_time().time_since_epoch().count() < watermark)
+            continue;
+
+        paths.push_back(it->path().string());
+    }
+
+    if (snapshotResumed && paths.empty())
+        return true;
 
     std::cout << "Start adding " << paths.size() << " schemes from " << outputPath << std::endl;
     std::vector<std::vector<Scheme>> pool(threads);
@@ -221,6 +289,104 @@ bool MetaFlipGraphPool<Scheme>::resume() {
     return valid;
 }
 
+template <typename Scheme>
+bool MetaFlipGraphPool<Scheme>::resumeSnapshot(const std::string &path, int64_t &watermark) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    PoolSnapshot snapshot;
+
+    if (!snapshot.open(path))
+        return false;
+
+    const PoolSnapshotHeader &header = snapshot.getHeader();
+    PoolSnapshotHeader expected = getSnapshotHeader();
+
+    if (header.ring != expected.ring || header.uniqueType != expected.uniqueType) {
+        std::cout << "Pool snapshot was saved for " << header.ring << " schemes with unique type \"" << header.uniqueType << "\", ";
+        std::cout << "but got " << expected.ring << " schemes with unique type \"" << expected.uniqueType << "\"" << std::endl;
+        return false;
+    }
+
+    for (const PoolSnapshotSection &section : snapshot.getSections()) {
+        if (section.count == 0)
+            continue;
+
+        Scheme scheme;
+        if (!scheme.unpackTerms(snapshot.getData(section), section.recordSize)) {
+            std::cout << "Invalid pool snapshot: unexpected records of " << section.dimension << " rank " << section.rank << std::endl;
+            return false;
+        }
+
+        if (scheme.getDimension() != section.dimension || scheme.getRank() != section.rank || !scheme.validate()) {
+            std::cout << "Invalid pool snapshot: corrupted schemes of " << section.dimension << " rank " << section.rank << std::endl;
+            return false;
+        }
+    }
+
+    size_t total = 0;
+    for (const PoolSnapshotSection &section : snapshot.getSections()) {
+        getPools(section.dimension).readSnapshot(section, snapshot.getData(section));
+        total += section.count;
+    }
+
+    watermark = header.watermark;
+
+    double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count() / 1000.0;
+    std::cout << "Resumed " << total << " schemes of " << dimensions.size() << " dimensions from pool snapshot \"" << path << "\" in " << prettyTime(elapsed) << std::endl;
+    return true;
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::saveSnapshot() {
+    // taken before collecting sections, so schemes saved during collection are read again on resume instead of being lost
+    int64_t watermark = std::filesystem::file_time_type::clock::now().time_since_epoch().count();
+    std::vector<PoolSnapshotSection> sections;
+    std::vector<const SchemesPool<Scheme>*> pools;
+
+    for (const std::string &dimension : dimensions) {
+        const SchemesRankPool<Scheme> &rankPool = dimension2pools.at(dimension);
+
+        for (int rank : rankPool.getRanks()) {
+            const SchemesPool<Scheme> &pool = rankPool.getPool(rank);
+            PoolSnapshotSection section = pool.getSnapshotSection();
+            section.dimension = dimension;
+            section.rank = rank;
+            sections.push_back(section);
+            pools.push_back(&pool);
+        }
+    }
+
+    PoolSnapshotHeader header = getSnapshotHeader();
+    header.watermark = watermark;
+
+    std::stringstream ss;
+    header.write(ss, sections);
+
+    for (const SchemesPool<Scheme> *pool : pools)
+        pool->writeSnapshot(ss);
+
+    if (!makeDirectory(outputPath))
+        return;
+
+    snapshotWriter.write(getSnapshotPath(), ss.str());
+}
+
+template <typename Scheme>
+std::string MetaFlipGraphPool<Scheme>::getSnapshotPath() const {
+    return outputPath + "/pool_snapshot.bin";
+}
+
+template <typename Scheme>
+PoolSnapshotHeader MetaFlipGraphPool<Scheme>::getSnapshotHeader() const {
+    Scheme scheme;
+    scheme.initializeNaive(1, 1, 1);
+
+    PoolSnapshotHeader header;
+    header.ring = scheme.getRing();
+    header.uniqueType = poolParameters.uniqueType;
+    header.watermark = 0;
+    return header;
+}
+
 template <typename Scheme>
 void MetaFlipGraphPool<Scheme>::runIteration() {
     std::vector<std::vector<Scheme>> pool(threads);
@@ -229,19 +395,42 @@ void MetaFlipGraphPool<Scheme>::runIteration() {
     for (auto& pair : dimension2pools)
         pair.second.resetDiff();
 
-    #pragma omp parallel for num_threads(threads)
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
     for (int i = 0; i < count; i++) {
-        int thread = omp_get_thread_num();
-        randomWalk(schemes[i], flips[i], ranks[i], iterations[i], plusIterations[i], pool[thread], generators[thread]);
+        randomWalk(*runners[i], pool[omp_get_thread_num()]);
     }
 
-    for (int i = 0; i < threads; i++)
-        for (const Scheme &scheme : pool[i])
-            addScheme(scheme, true);
+    addSchemes(pool);
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::randomWalk(Scheme &scheme, size_t &flipsCount, int &runnerRank, size_t &iterationsCount, size_t &plusIterations, std::vector<Scheme> &pool, std::mt19937 &generator) {
+OperationCounters MetaFlipGraphPool<Scheme>::getCounters() const {
+    OperationCounters total;
+
+    for (int i = 0; i < count; i++)
+        total += runners[i]->scheme.getCounters();
+
+    return total;
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::updateCounters(double elapsed) {
+    OperationCounters total = getCounters();
+    iterationCounters = total - lastCounters;
+    lastCounters = total;
+    iterationTime = elapsed;
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::randomWalk(Runner &runner, std::vector<Scheme> &pool) {
+    Scheme &scheme = runner.scheme;
+    RandomGenerator &generator = runner.generator;
+    int &runnerRank = runner.rank;
+
+    size_t flipsCount = runner.flips;
+    size_t iterationsCount = runner.iterations;
+    size_t plusIterations = runner.plusIterations;
+
     for (size_t iteration = 0; iteration < flipParameters.flipIterations; iteration++) {
         if (iterationsCount == 0 || iterationsCount >= flipParameters.resetIterations) {
             selectRunner(scheme, generator);
@@ -289,6 +478,10 @@ void MetaFlipGraphPool<Scheme>::randomWalk(Scheme &scheme, size_t &flipsCount, i
             flipsCount = 0;
     }
 
+    runner.flips = flipsCount;
+    runner.iterations = iterationsCount;
+    runner.plusIterations = plusIterations;
+
     if (scheme.getRank() > runnerRank)
         return;
 
@@ -313,29 +506,37 @@ void MetaFlipGraphPool<Scheme>::report(size_t iteration, std::chrono::high_resol
     size_t rediscovered = 0;
     size_t total = 0;
     size_t diff = 0;
-
-    std::cout << "+------------------------------------------------------------------------+" << std::endl << std::left;
-    std::cout << "| seed: " << std::setw(64) << seed << " |" << std::endl;
-    std::cout << "| runners: " << std::setw(61) << count << " |" << std::endl;
-    std::cout << "| threads: " << std::setw(61) << threads << " |" << std::endl;
-    std::cout << "| iteration: " << std::setw(59) << iteration << " |" << std::endl;
-    std::cout << "| elapsed time: " << std::setw(56) << prettyTime(elapsed) << " |" << std::endl;
-    std::cout << "+-----------+------+-----------------+---------------+-------------------+" << std::endl;
-    std::cout << "|           |      |                 |  complexity   |  available flips  |" << std::endl;
-    std::cout << "| dimension | rank |   total count   |  min  |  max  |   min   |   max   |" << std::endl;
+    size_t fingerprints = 0;
+    size_t fingerprintsMemory = 0;
+    size_t memory = 0;
+    size_t diskUsage = 0;
+
+    std::cout << "+-------------------------------------------------------------------------------------+" << std::endl << std::left;
+    std::cout << "| seed: " << std::setw(77) << seed << " |" << std::endl;
+    std::cout << "| runners: " << std::setw(74) << count << " |" << std::endl;
+    std::cout << "| threads: " << std::setw(74) << threads << " |" << std::endl;
+    std::cout << "| iteration: " << std::setw(72) << iteration << " |" << std::endl;
+    std::cout << "| elapsed time: " << std::setw(69) << prettyTime(elapsed) << " |" << std::endl;
+    std::cout << "+-----------+------+-----------------+---------------+-------------------+------------+" << std::endl;
+    std::cout << "|           |      |                 |  complexity   |  available flips  |            |" << std::endl;
+    std::cout << "| dimension | rank |   total count   |  min  |  max  |   min   |   max   |   memory   |" << std::endl;
 
     for (const std::string &dimension : dimensions) {
         const SchemesRankPool<Scheme> &pool = dimension2pools.at(dimension);
         int knownRank = dimension2knownRank.at(dimension);
         diff += pool.print(knownRank);
         total += pool.size();
+        fingerprints += pool.getFingerprintsCount();
+        fingerprintsMemory += pool.getFingerprintsMemory();
+        memory += pool.getMemory();
+        diskUsage += pool.getDiskUsage();
 
         meanFillRatio += pool.minFillRatio();
         if (pool.minRank() == knownRank)
             rediscovered++;
     }
 
-    std::cout << "+-----------+------+-----------------+---------------+-------------------+" << std::endl;
+    std::cout << "+-----------+------+-----------------+---------------+-------------------+------------+" << std::endl;
     showImprovements();
     std::cout << "- iteration time (last / min / max / mean): " << prettyTime(lastTime) << " / " << prettyTime(minTime) << " / " << prettyTime(maxTime) << " / " << prettyTime(meanTime) << std::endl;
     std::cout << "- mean fill ratio: " << std::setprecision(3) << (meanFillRatio / dimensions.size()) << std::endl;
@@ -344,6 +545,14 @@ void MetaFlipGraphPool<Scheme>::report(size_t iteration, std::chrono::high_resol
         std::cout << " (+" << diff << ")";
     std::cout << std::endl;
     std::cout << "- rediscovered: " << rediscovered << " / " << dimensions.size() << std::endl;
+    std::cout << "- pools memory: " << prettyBytes(memory) << std::endl;
+    iterationCounters.print(std::cout, iterationTime);
+
+    if (!poolParameters.diskPath.empty())
+        std::cout << "- pools disk: " << prettyBytes(diskUsage) << std::endl;
+
+    if (!poolParameters.uniqueType.empty())
+        std::cout << "- unique fingerprints: " << fingerprints << " (memory: " << prettyBytes(fingerprintsMemory) << ")" << std::endl;
     std::cout << std::endl;
 }
 
@@ -359,16 +568,66 @@ void MetaFlipGraphPool<Scheme>::showImprovements() const {
 
         if (!showed) {
             showed = true;
-            std::cout << "| improvements:                                                          |" << std::endl;
+            std::cout << "| improvements:                                                                       |" << std::endl;
         }
 
         std::stringstream ss;
         ss << dimension << ": " << curr << " (" << known << ")";
-        std::cout << "| " << std::setw(70) << ss.str() << " |" << std::endl;
+        std::cout << "| " << std::setw(83) << ss.str() << " |" << std::endl;
     }
 
     if (showed)
-        std::cout << "+------------------------------------------------------------------------+" << std::endl << std::left;
+        std::cout << "+-------------------------------------------------------------------------------------+" << std::endl << std::left;
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::initializeMetrics() const {
+    if (!metricsParameters.use)
+        return;
+
+    std::ofstream f(metricsParameters.path);
+    if (!f) {
+        std::cout << "Unable to create file \"" << metricsParameters.path << "\" for append metrics" << std::endl;
+        return;
+    }
+
+    f << "{";
+    f << "\"count\": " << count << ", ";
+    f << "\"ring\": \"" << runners[0]->scheme.getRing() << "\", ";
+    f << "\"seed\": " << seed << ", ";
+    f << "\"random_walk_parameters\": ";
+    flipParameters.writeJSON(f);
+    f << ", \"pool_parameters\": ";
+    poolParameters.writeJSON(f);
+    f << "}" << std::endl;
+    f.close();
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::saveMetrics(size_t iteration) const {
+    if (!metricsParameters.use)
+        return;
+
+    std::ofstream f(metricsParameters.path, std::ios::app);
+    if (!f) {
+        std::cout << "Unable to open file \"" << metricsParameters.path << "\" for append metrics" << std::endl;
+        return;
+    }
+
+    size_t total = 0;
+    for (const std::string &dimension : dimensions)
+        total += dimension2pools.at(dimension).size();
+
+    f << "{";
+    f << "\"iteration\": " << iteration << ", ";
+    f << "\"dimensions\": " << dimensions.size() << ", ";
+    f << "\"total_schemes\": " << total << ", ";
+    f << "\"operations\": ";
+    iterationCounters.writeJSON(f);
+    f << ", \"flips_per_second\": " << (iterationTime > 0 ? iterationCounters.flips / iterationTime : 0);
+    f << ", \"operations_per_second\": " << (iterationTime > 0 ? iterationCounters.getOperations() / iterationTime : 0);
+    f << "}" << std::endl;
+    f.close();
 }
 
 template <typename Scheme>
@@ -410,14 +669,14 @@ void MetaFlipGraphPool<Scheme>::readPriorities() {
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::selectRunner(Scheme &scheme, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::selectRunner(Scheme &scheme, RandomGenerator &generator) {
     std::string dimension = selectDimension(generator);
     SchemesRankPool<Scheme> &pools = dimension2pools.at(dimension);
     pools.copyRandom(scheme, generator, poolParameters.selectRankScale);
 }
 
 template <typename Scheme>
-std::string MetaFlipGraphPool<Scheme>::selectDimension(std::mt19937 &generator) {
+std::string MetaFlipGraphPool<Scheme>::selectDimension(RandomGenerator &generator) {
     std::vector<double> weights(dimensions.size());
     double total = 0;
 
@@ -449,20 +708,78 @@ std::string MetaFlipGraphPool<Scheme>::selectDimension(std::mt19937 &generator)
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::addScheme(const Scheme &scheme, bool save) {
-    std::string dimension = scheme.getDimension();
-
+SchemesRankPool<Scheme>& MetaFlipGraphPool<Scheme>::getPools(const std::string &dimension) {
     if (dimension2pools.find(dimension) == dimension2pools.end()) {
         dimensions.push_back(dimension);
         std::sort(dimensions.begin(), dimensions.end(), [&](const std::string &d1, const std::string &d2) { return compareDimension(d1, d2); });
-        dimension2pools.emplace(dimension, SchemesRankPool<Scheme>(dimension, poolParameters.size, poolParameters.uniqueType, outputPath + "/" + dimension, format));
+        dimension2pools.emplace(dimension, SchemesRankPool<Scheme>(dimension, poolParameters.size, poolParameters.uniqueType, outputPath + "/" + dimension, format, poolParameters.diskPath, poolParameters.diskSize));
+    }
+
+    return dimension2pools.at(dimension);
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::addScheme(const Scheme &scheme, bool save) {
+    getPools(scheme.getDimension()).add(scheme, save);
+}
+
+template <typename Scheme>
+void MetaFlipGraphPool<Scheme>::addSchemes(const std::vector<std::vector<Scheme>> &pool) {
+    std::vector<const Scheme*> candidates;
+    std::vector<SchemesPool<Scheme>*> targets;
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<SchemesPool<Scheme>*, size_t> target2group;
+
+    for (int i = 0; i < threads; i++) {
+        for (const Scheme &scheme : pool[i]) {
+            SchemesPool<Scheme> *target = &getPools(scheme.getDimension()).createPool(scheme.getRank());
+            auto it = target2group.find(target);
+
+            if (it == target2group.end()) {
+                it = target2group.emplace(target, groups.size()).first;
+                groups.emplace_back();
+            }
+
+            groups[it->second].push_back(candidates.size());
+            candidates.push_back(&scheme);
+            targets.push_back(target);
+        }
+    }
+
+    std::vector<SchemeFingerprint> fingerprints(candidates.size());
+    std::vector<std::vector<uint8_t>> blobs(candidates.size());
+    std::vector<int> complexities(candidates.size());
+    std::vector<int> availableFlips(candidates.size());
+
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!poolParameters.uniqueType.empty())
+            fingerprints[i] = getUniqueFingerprint(*candidates[i], poolParameters.uniqueType);
+
+        candidates[i]->packTerms(blobs[i]);
+        complexities[i] = candidates[i]->getComplexity();
+        availableFlips[i] = candidates[i]->getAvailableFlips();
+    }
+
+    std::vector<uint8_t> stored(candidates.size(), 0);
+
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
+    for (size_t group = 0; group < groups.size(); group++) {
+        for (size_t i : groups[group]) {
+            bool isStored;
+            targets[i]->addPacked(fingerprints[i], blobs[i], complexities[i], availableFlips[i], isStored);
+            stored[i] = isStored && targets[i]->makeSaveDirectory();
+        }
     }
 
-    dimension2pools.at(dimension).add(scheme, save);
+    #pragma omp parallel for num_threads(threads) schedule(dynamic)
+    for (size_t i = 0; i < candidates.size(); i++)
+        if (stored[i])
+            targets[i]->saveScheme(*candidates[i]);
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::metaScheme(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::metaScheme(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator) {
     std::string dimension = scheme.getDimension();
     int rank = scheme.getRank();
 
@@ -487,7 +804,7 @@ void MetaFlipGraphPool<Scheme>::metaScheme(const Scheme &scheme, std::vector<Sch
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::tryExtend(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::tryExtend(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator) {
     for (int i = 0; i < 3; i++) {
         if (!scheme.isValidExtension(i, metaParameters.maxDimension, metaParameters.maxRank))
             continue;
@@ -506,7 +823,7 @@ void MetaFlipGraphPool<Scheme>::tryExtend(const Scheme &scheme, std::vector<Sche
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::tryProject(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::tryProject(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator) {
     for (int i = 0; i < 3; i++) {
         if (!scheme.isValidProject(i, metaParameters.minDimension))
             continue;
@@ -527,7 +844,7 @@ void MetaFlipGraphPool<Scheme>::tryProject(const Scheme &scheme, std::vector<Sch
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::tryProduct(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::tryProduct(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator) {
     for (int n1 = 2; scheme.getDimension(0) * n1 <= metaParameters.maxDimension; n1++) {
         for (int n2 = 2; scheme.getDimension(1) * n2 <= metaParameters.maxDimension; n2++) {
             for (int n3 = 2; scheme.getDimension(2) * n3 <= metaParameters.maxDimension; n3++) {
@@ -558,7 +875,7 @@ void MetaFlipGraphPool<Scheme>::tryProduct(const Scheme &scheme, std::vector<Sch
 }
 
 template <typename Scheme>
-void MetaFlipGraphPool<Scheme>::tryMerge(const Scheme &scheme, std::vector<Scheme> &schemesPool, std::mt19937 &generator) {
+void MetaFlipGraphPool<Scheme>::tryMerge(const Scheme &scheme, std::vector<Scheme> &schemesPool, RandomGenerator &generator) {
     for (int i = 0; i < 3; i++) {
         for (int ni = 2; ni <= scheme.getDimension(i) && ni + scheme.getDimension(i) <= metaParameters.maxDimension; ni++) {
             int n[3] = {scheme.getDimension(0), scheme.getDimension(1), scheme.getDimension(2)};
@@ -0,0 +1,25 @@
+#include "checkpoint_parameters.h"
+
+void CheckpointParameters::parse(const ArgParser &parser) {
+    use = parser.isSet("--save-checkpoints");
+    path = parser["--checkpoint-path"];
+    interval = std::stoi(parser["--checkpoint-interval"]);
+}
+
+std::ostream& operator<<(std::ostream& os, const CheckpointParameters &checkpointParameters) {
+    if (checkpointParameters.use) {
+        os << "Checkpoint parameters:" << std::endl;
+        os << "- path: " << checkpointParameters.path << std::endl;
+        os << "- interval: " << checkpointParameters.interval << " s" << std::endl;
+    }
+
+    return os;
+}
+
+void CheckpointParameters::addToParser(ArgParser &parser, const std::string &sectionName) {
+    parser.addSection(sectionName);
+    parser.add("--save-checkpoints", ArgType::Flag, "Periodically save full runners state, SIGINT / SIGTERM saves a final checkpoint and stops");
+    parser.add("--checkpoint-path", ArgType::Path, "Path to checkpoint file", "schemes/checkpoint.bin");
+    parser.add("--checkpoint-interval", ArgType::UInt, "Seconds between checkpoints, 0 saves after every iteration", "600");
+    parser.add("--resume-checkpoint", ArgType::Path, "Resume search from checkpoint file instead of initial schemes");
+}
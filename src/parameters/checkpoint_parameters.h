@@ -0,0 +1,16 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include "../entities/arg_parser.h"
+
+struct CheckpointParameters {
+    bool use;
+    std::string path;
+    int interval;
+
+    void parse(const ArgParser &parser);
+    friend std::ostream& operator<<(std::ostream& os, const CheckpointParameters &checkpointParameters);
+
+    static void addToParser(ArgParser &parser, const std::string &sectionName);
+};
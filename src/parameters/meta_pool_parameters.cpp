@@ -4,7 +4,10 @@ void MetaPoolParameters::parse(const ArgParser &parser) {
     use = parser.isSet("--use-pool");
     size = parseNatural(parser["--pool-size"]);
     uniqueType = parser["--pool-unique-type"];
+    diskPath = parser["--pool-disk-path"];
+    diskSize = parseNatural(parser["--pool-disk-size"]);
     resume = parser.isSet("--resume");
+    snapshotInterval = std::stoi(parser["--pool-snapshot-interval"]);
     liftOnly = parser.isSet("--lift-only");
     alternativesProbability = std::stod(parser["--save-alternatives-probability"]);
 
@@ -36,7 +39,10 @@ void MetaPoolParameters::writeJSON(std::ostream &os) const {
     os << "{";
     os << "\"size\": " << size << ", ";
     os << "\"unique_type\": \"" << uniqueType << "\", ";
+    os << "\"disk_path\": \"" << diskPath << "\", ";
+    os << "\"disk_size\": " << diskSize << ", ";
     os << "\"resume\": " << (resume ? "true" : "false") << ", ";
+    os << "\"snapshot_interval\": " << snapshotInterval << ", ";
     os << "\"lift_only\": " << (liftOnly ? "true" : "false") << ", ";
     os << "\"save_alternatives_probability\": " << alternativesProbability << ", ";
     os << "\"merge_max_diff\": " << mergeMaxDiff << ", ";
@@ -60,8 +66,11 @@ std::ostream& operator<<(std::ostream& os, const MetaPoolParameters &parameters)
         os << "Pool parameters:" << std::endl;
         os << "- size: " << parameters.size << std::endl;
         os << "- unique only: " << (parameters.uniqueType.empty() ? "no" : "yes") << (parameters.uniqueType.empty() ? "" : " (" + parameters.uniqueType + ")") << std::endl;
+        if (!parameters.diskPath.empty())
+            os << "- disk tier: " << parameters.diskPath << " (max " << parameters.diskSize << " schemes per pool)" << std::endl;
         os << "- liftable only: " << (parameters.liftOnly ? "yes" : "no") << std::endl;
         os << "- resume: " << (parameters.resume ? "yes" : "no") << std::endl;
+        os << "- snapshot interval: " << (parameters.snapshotInterval ? std::to_string(parameters.snapshotInterval) + " s" : "disabled") << std::endl;
         os << "- save alternatives probability: " << parameters.alternativesProbability << std::endl;
         os << "- merge parameters (max diff: " << parameters.mergeMaxDiff << ", probability: " << parameters.mergeProbability << ")" << std::endl;
         os << "- extend parameters (max diff: " << parameters.extendMaxDiff << ", probability: " << parameters.extendProbability << ")" << std::endl;
@@ -82,7 +91,10 @@ void MetaPoolParameters::addToParser(ArgParser &parser, const std::string &secti
     parser.add("--use-pool", ArgType::Flag, "Use pool strategy");
     parser.add("--pool-size", ArgType::Natural, "Optimal size of pool", "1K");
     parser.addChoices("--pool-unique-type", ArgType::String, "Unique schemes check", {"structure", "coefficients", "type"}, "");
-    parser.add("--resume", ArgType::Flag, "Read schemes from output directories as initial");
+    parser.add("--pool-disk-path", ArgType::String, "Directory for memory-mapped overflow of full pools (if empty, overwrite old schemes)", "");
+    parser.add("--pool-disk-size", ArgType::Natural, "Max schemes per pool kept in the disk tier before old schemes are overwritten", "1M");
+    parser.add("--resume", ArgType::Flag, "Read schemes from pool snapshot or output directories as initial");
+    parser.add("--pool-snapshot-interval", ArgType::UInt, "Seconds between binary pool snapshots used by --resume, 0 disables snapshots", "600");
     parser.add("--lift-only", ArgType::Flag, "Save only schemes that can lift");
     parser.add("--save-alternatives-probability", ArgType::Real, "Save alternative schemes after runner end probability", "0.01");
 
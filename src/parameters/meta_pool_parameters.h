@@ -8,7 +8,10 @@ struct MetaPoolParameters {
     bool use;
     size_t size;
     std::string uniqueType;
+    std::string diskPath;
+    size_t diskSize;
     bool resume;
+    int snapshotInterval;
     bool liftOnly;
     double alternativesProbability;
 
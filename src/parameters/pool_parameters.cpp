@@ -7,6 +7,9 @@ void PoolParameters::parse(const ArgParser &parser) {
     maxIterations = parseNatural(parser["--pool-max-iterations"]);
     uniqueType = parser["--pool-unique-type"];
     selectStrategy = parser["--pool-select-strategy"];
+    diskPath = parser["--pool-disk-path"];
+    memorySize = parseNatural(parser["--pool-memory-size"]);
+    pipelineRatio = std::stod(parser["--pool-pipeline-ratio"]);
 }
 
 void PoolParameters::writeJSON(std::ostream &os) const {
@@ -15,7 +18,10 @@ void PoolParameters::writeJSON(std::ostream &os) const {
     os << "\"min_size\": " << minSize << ", ";
     os << "\"max_iterations\": " << maxIterations << ", ";
     os << "\"unique_type\": \"" << uniqueType << "\", ";
-    os << "\"select_strategy\": \"" << selectStrategy << "\"";
+    os << "\"select_strategy\": \"" << selectStrategy << "\", ";
+    os << "\"disk_path\": \"" << diskPath << "\", ";
+    os << "\"memory_size\": " << memorySize << ", ";
+    os << "\"pipeline_ratio\": " << pipelineRatio;
     os << "}";
 }
 
@@ -26,6 +32,10 @@ std::ostream& operator<<(std::ostream& os, const PoolParameters &poolParameters)
         os << "- max iterations: " << poolParameters.maxIterations << std::endl;
         os << "- save unique only: " << (poolParameters.uniqueType.empty() ? "no" : "yes") << (poolParameters.uniqueType.empty() ? "" : " (" + poolParameters.uniqueType + ")") << std::endl;
         os << "- select strategy: " << poolParameters.selectStrategy << std::endl;
+        os << "- pipeline ratio: " << poolParameters.pipelineRatio << std::endl;
+
+        if (!poolParameters.diskPath.empty())
+            os << "- disk tier: " << poolParameters.diskPath << " (in memory: " << poolParameters.memorySize << " schemes)" << std::endl;
     }
 
     return os;
@@ -39,4 +49,7 @@ void PoolParameters::addToParser(ArgParser &parser, const std::string &sectionNa
     parser.add("--pool-max-iterations", ArgType::Natural, "Max random walk iterations to reach min pool size", "1K");
     parser.addChoices("--pool-unique-type", ArgType::String, "Keep schemes with unique property values (if empty, keep all)", {"structure", "coefficients", "type"}, "");
     parser.addChoices("--pool-select-strategy", ArgType::String, "Pool selection strategy", {"uniform", "flips"}, "uniform");
+    parser.add("--pool-disk-path", ArgType::String, "Directory for memory-mapped pool files (if empty, keep pool in memory)", "");
+    parser.add("--pool-memory-size", ArgType::Natural, "Max schemes kept in memory per pool before spilling to disk", "1M");
+    parser.add("--pool-pipeline-ratio", ArgType::Real, "Fraction of runners walking the next-rank pool while it is still filling, from 0.0 to 1.0", "0");
 }
@@ -11,6 +11,9 @@ struct PoolParameters {
     size_t minSize;
     std::string uniqueType;
     std::string selectStrategy;
+    std::string diskPath;
+    size_t memorySize;
+    double pipelineRatio;
 
     void parse(const ArgParser &parser);
     void writeJSON(std::ostream &os) const;
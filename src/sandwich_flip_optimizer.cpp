@@ -1,6 +1,6 @@
 #include "sandwich_flip_optimizer.h"
 
-SandwichFlipOptimizer::SandwichFlipOptimizer(int count, const std::string &outputPath, int threads, const SandwichFlipParameters &sandwichFlipParameters, const SandwichingParameters &sandwichingParameters, const ScaleParameters &scaleParameters, const PlusParameters &plusParameters, int seed, size_t maxImprovements, const std::string &format) : uniform(0.0, 1.0) {
+SandwichFlipOptimizer::SandwichFlipOptimizer(int count, const std::string &outputPath, int threads, const SandwichFlipParameters &sandwichFlipParameters, const SandwichingParameters &sandwichingParameters, const ScaleParameters &scaleParameters, const PlusParameters &plusParameters, int seed, const std::string &generatorType, size_t maxImprovements, const std::string &format) : uniform(0.0, 1.0) {
     this->count = count;
     this->outputPath = outputPath;
     this->threads = threads;
@@ -14,7 +14,7 @@ SandwichFlipOptimizer::SandwichFlipOptimizer(int count, const std::string &outpu
     this->maxImprovements = maxImprovements;
     this->format = format;
 
-    generators = initRandomGenerators(seed, threads);
+    generators = initRandomGenerators(seed, count, generatorType);
     schemes.resize(count);
     bestSchemes.resize(count);
     weights.resize(count);
@@ -82,7 +82,7 @@ void SandwichFlipOptimizer::run(size_t maxNoImprovements) {
     for (size_t iteration = 0; iteration < maxNoImprovements; iteration++) {
         #pragma omp parallel for num_threads(threads) schedule(dynamic, 32)
         for (int i = 0; i < count; i++)
-            optimize(schemes[i], bestSchemes[i], weights[i], uvw[0][i], uvw[1][i], uvw[2][i], uvw1[0][i], uvw1[1][i], uvw1[2][i], generators[omp_get_thread_num()]);
+            optimize(schemes[i], bestSchemes[i], weights[i], uvw[0][i], uvw[1][i], uvw[2][i], uvw1[0][i], uvw1[1][i], uvw1[2][i], generators[i]);
 
         int imin = -1;
         for (int i = 0; i < count; i++) {
@@ -146,7 +146,7 @@ void SandwichFlipOptimizer::initialize() {
     }
 }
 
-void SandwichFlipOptimizer::optimize(FractionalScheme &scheme, FractionalScheme &bestScheme, Weight &weight, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, std::mt19937 &generator) {
+void SandwichFlipOptimizer::optimize(FractionalScheme &scheme, FractionalScheme &bestScheme, Weight &weight, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, RandomGenerator &generator) {
     scheme.copy(improvements[generator() % improvements.size()]);
 
     int steps = sandwichFlipParameters.minSteps + generator() % (sandwichFlipParameters.maxSteps - sandwichFlipParameters.minSteps + 1);
@@ -201,7 +201,7 @@ void SandwichFlipOptimizer::addImprovement(const FractionalScheme &scheme) {
     improvementsIndex = (improvementsIndex + 1) % maxImprovements;
 }
 
-void SandwichFlipOptimizer::makeSandwiching(FractionalScheme &scheme, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, std::mt19937 &generator) {
+void SandwichFlipOptimizer::makeSandwiching(FractionalScheme &scheme, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, RandomGenerator &generator) {
     int n1 = scheme.getDimension(0);
     int n2 = scheme.getDimension(1);
     int n3 = scheme.getDimension(2);
@@ -246,7 +246,7 @@ void SandwichFlipOptimizer::makeSandwiching(FractionalScheme &scheme, Matrix &u,
     scheme.sandwiching(u, v, w, u1, v1, w1);
 }
 
-void SandwichFlipOptimizer::makeScale(FractionalScheme &scheme, std::mt19937 &generator) {
+void SandwichFlipOptimizer::makeScale(FractionalScheme &scheme, RandomGenerator &generator) {
     Fraction alpha = scaleParameters.values[generator() % scaleParameters.values.size()];
     Fraction beta = scaleParameters.values[generator() % scaleParameters.values.size()];
     Fraction gamma = scaleParameters.values[generator() % scaleParameters.values.size()];
@@ -284,7 +284,7 @@ void SandwichFlipOptimizer::makeScale(FractionalScheme &scheme, std::mt19937 &ge
     }
 }
 
-void SandwichFlipOptimizer::makePlus(FractionalScheme &scheme, std::mt19937 &generator) {
+void SandwichFlipOptimizer::makePlus(FractionalScheme &scheme, RandomGenerator &generator) {
     int rank = scheme.getRank();
 
     if (generator() % 2) {
@@ -298,7 +298,7 @@ void SandwichFlipOptimizer::makePlus(FractionalScheme &scheme, std::mt19937 &gen
         scheme.tryFlip(generator);
 }
 
-void SandwichFlipOptimizer::randomMatrix(Matrix &matrix, Matrix &inverse, int n, std::mt19937 &generator) {
+void SandwichFlipOptimizer::randomMatrix(Matrix &matrix, Matrix &inverse, int n, RandomGenerator &generator) {
     std::vector<int> rows(n);
     std::vector<int> columns(n);
 
@@ -423,7 +423,7 @@ void SandwichFlipOptimizer::printHeader() const {
     std::cout << divider << std::endl;
 }
 
-Weight SandwichFlipOptimizer::getWeight(const FractionalScheme &scheme, std::mt19937 &generator) {
+Weight SandwichFlipOptimizer::getWeight(const FractionalScheme &scheme, RandomGenerator &generator) {
     Weight weight;
     weight.norm = sandwichFlipParameters.minimizeNorm ? scheme.getFrobeniusNorm() : 0;
     weight.omega = sandwichFlipParameters.minimizeOmega ? scheme.getStructureOptimizer().optimize(generator, 100, 1e-15).omega : scheme.getOmega();
@@ -56,29 +56,29 @@ class SandwichFlipOptimizer {
     std::vector<Matrix> uvw1[3];
     Weight bestWeight;
 
-    std::vector<std::mt19937> generators;
+    std::vector<RandomGenerator> generators;
     std::uniform_real_distribution<double> uniform;
 public:
-    SandwichFlipOptimizer(int count, const std::string &outputPath, int threads, const SandwichFlipParameters &sandwichFlipParameters, const SandwichingParameters &sandwichingParameters, const ScaleParameters &scaleParameters, const PlusParameters &plusParameters, int seed, size_t maxImprovements, const std::string &format);
+    SandwichFlipOptimizer(int count, const std::string &outputPath, int threads, const SandwichFlipParameters &sandwichFlipParameters, const SandwichingParameters &sandwichingParameters, const ScaleParameters &scaleParameters, const PlusParameters &plusParameters, int seed, const std::string &generatorType, size_t maxImprovements, const std::string &format);
 
     bool initializeFromFile(const std::string &path, bool checkCorrectness, bool integer);
 
     void run(size_t maxNoImprovements);
 private:
     void initialize();
-    void optimize(FractionalScheme &scheme, FractionalScheme &bestScheme, Weight &weight, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, std::mt19937 &generator);
+    void optimize(FractionalScheme &scheme, FractionalScheme &bestScheme, Weight &weight, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, RandomGenerator &generator);
 
     void resetImprovements();
     void addImprovement(const FractionalScheme &scheme);
 
-    void makeSandwiching(FractionalScheme &scheme, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, std::mt19937 &generator);
-    void makeScale(FractionalScheme &scheme, std::mt19937 &generator);
-    void makePlus(FractionalScheme &scheme, std::mt19937 &generator);
+    void makeSandwiching(FractionalScheme &scheme, Matrix &u, Matrix &v, Matrix &w, Matrix &u1, Matrix &v1, Matrix &w1, RandomGenerator &generator);
+    void makeScale(FractionalScheme &scheme, RandomGenerator &generator);
+    void makePlus(FractionalScheme &scheme, RandomGenerator &generator);
 
-    void randomMatrix(Matrix &matrix, Matrix &inverse, int n, std::mt19937 &generator);
+    void randomMatrix(Matrix &matrix, Matrix &inverse, int n, RandomGenerator &generator);
     void saveScheme(const FractionalScheme &scheme, const Weight &weight) const;
     void printHeader() const;
 
-    Weight getWeight(const FractionalScheme &scheme, std::mt19937 &generator);
+    Weight getWeight(const FractionalScheme &scheme, RandomGenerator &generator);
     bool compareWeight(const Weight &w1, const Weight &w2);
 };
@@ -36,10 +36,10 @@ class SchemeOptimizer {
     std::vector<int> indices;
     OptimizerMetric bestMetric;
 
-    std::vector<std::mt19937> generators;
+    std::vector<RandomGenerator> generators;
     std::uniform_real_distribution<double> uniform;
 public:
-    SchemeOptimizer(int count, const std::string &outputPath, int threads, size_t flipIterations, double plusProbability, int plusDiff, double sandwichingProbability, int seed, double copyBestProbability, bool maximizeFlips, int topCount, const std::string &format);
+    SchemeOptimizer(int count, const std::string &outputPath, int threads, size_t flipIterations, double plusProbability, int plusDiff, double sandwichingProbability, int seed, const std::string &generatorType, double copyBestProbability, bool maximizeFlips, int topCount, const std::string &format);
 
     bool initializeFromFile(const std::string &path, bool multiple, bool checkCorrectness);
     void run(int maxNoImprovements);
@@ -47,7 +47,7 @@ private:
     void initialize();
     void optimizeIteration();
 
-    void optimize(Scheme &scheme, Scheme &schemeBest, OptimizerMetric &bestMetric, std::mt19937 &generator);
+    void optimize(Scheme &scheme, Scheme &schemeBest, OptimizerMetric &bestMetric, RandomGenerator &generator);
     bool updateBest();
     void report(size_t iteration, std::chrono::high_resolution_clock::time_point startTime, const std::vector<double> &elapsedTimes) const;
 
@@ -57,7 +57,7 @@ private:
 };
 
 template <typename Scheme>
-SchemeOptimizer<Scheme>::SchemeOptimizer(int count, const std::string &outputPath, int threads, size_t flipIterations, double plusProbability, int plusDiff, double sandwichingProbability, int seed, double copyBestProbability, bool maximizeFlips, int topCount, const std::string &format) : uniform(0.0, 1.0) {
+SchemeOptimizer<Scheme>::SchemeOptimizer(int count, const std::string &outputPath, int threads, size_t flipIterations, double plusProbability, int plusDiff, double sandwichingProbability, int seed, const std::string &generatorType, double copyBestProbability, bool maximizeFlips, int topCount, const std::string &format) : uniform(0.0, 1.0) {
     this->initialCount = 0;
     this->count = count;
     this->outputPath = outputPath;
@@ -73,7 +73,7 @@ SchemeOptimizer<Scheme>::SchemeOptimizer(int count, const std::string &outputPat
     this->format = format;
     this->bestMetric = {0, 0};
 
-    generators = initRandomGenerators(seed, threads);
+    generators = initRandomGenerators(seed, count, generatorType);
 
     schemes.resize(count);
     schemesBest.resize(count);
@@ -170,11 +170,11 @@ template <typename Scheme>
 void SchemeOptimizer<Scheme>::optimizeIteration() {
     #pragma omp parallel for num_threads(threads)
     for (int i = 0; i < count; i++)
-        optimize(schemes[i], schemesBest[i], bestMetrics[i], generators[omp_get_thread_num()]);
+        optimize(schemes[i], schemesBest[i], bestMetrics[i], generators[i]);
 }
 
 template <typename Scheme>
-void SchemeOptimizer<Scheme>::optimize(Scheme &scheme, Scheme &schemeBest, OptimizerMetric &bestMetric, std::mt19937 &generator) {
+void SchemeOptimizer<Scheme>::optimize(Scheme &scheme, Scheme &schemeBest, OptimizerMetric &bestMetric, RandomGenerator &generator) {
     int targetRank = schemeBest.getRank();
 
     for (size_t iteration = 0; iteration < flipIterations; iteration++) {
@@ -206,7 +206,7 @@ bool SchemeOptimizer<Scheme>::updateBest() {
 
     #pragma omp parallel for num_threads(threads)
     for (int i = 0; i < count; i++)
-        if (uniform(generators[omp_get_thread_num()]) < copyBestProbability)
+        if (uniform(generators[i]) < copyBestProbability)
             schemes[i].copy(schemesBest[indices[0]]);
 
     int top = indices[0];
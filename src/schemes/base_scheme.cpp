@@ -58,6 +58,18 @@ int BaseScheme::getIndependentFlips() const {
     return independent;
 }
 
+const OperationCounters& BaseScheme::getCounters() const {
+    return counters;
+}
+
+void BaseScheme::copyCounters(const BaseScheme &scheme) {
+    counters = scheme.counters;
+}
+
+const SchemeFingerprint& BaseScheme::getFingerprint() const {
+    return fingerprint;
+}
+
 double BaseScheme::getOmega() const {
     return 3 * log(rank) / log(dimension[0] * dimension[1] * dimension[2]);
 }
@@ -77,3 +89,34 @@ FlipStructureOptimizer BaseScheme::getStructureOptimizer() const {
     optimizer.preprocess();
     return optimizer;
 }
+
+SchemeFingerprint BaseScheme::getDimensionFingerprint() const {
+    return SchemeFingerprint(hashBits(uint64_t(dimension[0]) | (uint64_t(dimension[1]) << 16) | (uint64_t(dimension[2]) << 32)));
+}
+
+void BaseScheme::packBase(std::ostream &os) const {
+    writeBinary(os, dimension);
+    writeBinary(os, rank);
+    writeBinary(os, counters);
+
+    for (int i = 0; i < 3; i++)
+        flips[i].pack(os);
+}
+
+bool BaseScheme::unpackBase(std::istream &is) {
+    if (!readBinary(is, dimension) || !readBinary(is, rank) || !readBinary(is, counters))
+        return false;
+
+    // every term takes at least a byte, so a corrupted rank is rejected before the rows are reserved
+    if (rank < 0 || !checkBinarySize(is, rank, 1))
+        return false;
+
+    for (int i = 0; i < 3; i++)
+        elements[i] = dimension[i] * dimension[(i + 1) % 3];
+
+    for (int i = 0; i < 3; i++)
+        if (!flips[i].unpack(is))
+            return false;
+
+    return true;
+}
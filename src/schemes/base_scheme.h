@@ -7,15 +7,25 @@
 #include <cmath>
 
 #include "../entities/flip_set.h"
+#include "../entities/flip_buckets.h"
+#include "../entities/brent_validator.h"
+#include "../entities/bit_hash.hpp"
 #include "../entities/flip_structure_optimizer.h"
+#include "../entities/operation_counters.h"
+#include "../entities/scheme_fingerprint.hpp"
 
-class BaseScheme {
+class alignas(64) BaseScheme {
 protected:
     int dimension[3];
     int elements[3];
     int rank;
 
     FlipSet flips[3];
+    FlipBuckets buckets[3];
+    std::vector<uint32_t> bucketIndices;
+
+    OperationCounters counters;
+    SchemeFingerprint fingerprint;
 
     std::uniform_int_distribution<int> boolDistribution;
     std::uniform_int_distribution<int> ijkDistribution;
@@ -30,9 +40,16 @@ public:
     int getAvailableFlips() const;
     int getAvailableFlips(int index) const;
     int getIndependentFlips() const;
+    const OperationCounters& getCounters() const;
+    void copyCounters(const BaseScheme &scheme);
+    const SchemeFingerprint& getFingerprint() const;
     double getOmega() const;
 
     std::string getStructureHash() const;
 
     FlipStructureOptimizer getStructureOptimizer() const;
+protected:
+    SchemeFingerprint getDimensionFingerprint() const;
+    void packBase(std::ostream &os) const;
+    bool unpackBase(std::istream &is);
 };
@@ -13,7 +13,8 @@
 #include "../algebra/mod_matrix.h"
 #include "../entities/ranks.h"
 #include "../entities/invariants_builder.h"
-#include "../entities/uint256_t.h"
+#include "../entities/bit_vector.hpp"
+#include "../entities/scheme_arena.hpp"
 #include "../lift/binary_lifter.h"
 #include "fractional_scheme.h"
 #include "base_scheme.h"
@@ -21,7 +22,8 @@
 template <typename T>
 class BinaryScheme : public BaseScheme {
 protected:
-    std::vector<T> uvw[3];
+    SchemeArena<T> uvw;
+    std::vector<int> reduceCandidates;
 public:
     BinaryScheme();
     BinaryScheme(const BinaryScheme<T> &scheme);
@@ -40,17 +42,17 @@ public:
     std::vector<std::vector<int>> getExpressionsV() const;
     std::vector<std::vector<int>> getExpressionsW() const;
 
-    bool tryFlip(std::mt19937 &generator);
-    bool tryPlus(std::mt19937 &generator);
-    bool trySplit(std::mt19937 &generator);
-    bool tryExpand(std::mt19937 &generator);
-    bool trySandwiching(std::mt19937 &generator);
+    bool tryFlip(RandomGenerator &generator);
+    bool tryPlus(RandomGenerator &generator);
+    bool trySplit(RandomGenerator &generator);
+    bool tryExpand(RandomGenerator &generator);
+    bool trySandwiching(RandomGenerator &generator);
     bool tryReduce();
     bool check2Reduce() const;
 
-    bool tryProject(std::mt19937 &generator, int minN);
-    bool tryExtend(std::mt19937 &generator, int maxN, int maxRank);
-    bool tryMerge(const BinaryScheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank);
+    bool tryProject(RandomGenerator &generator, int minN);
+    bool tryExtend(RandomGenerator &generator, int maxN, int maxRank);
+    bool tryMerge(const BinaryScheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank);
     bool tryProduct(const BinaryScheme<T> &scheme, int maxN, int maxRank);
 
     bool isValidProject(int p, int minN) const;
@@ -60,7 +62,7 @@ public:
 
     void fixSizes();
     void setSizes(int n1, int n2, int n3);
-    void swapSizes(std::mt19937 &generator);
+    void swapSizes(RandomGenerator &generator);
     void swapSizes(int p1, int p2);
     void merge(const BinaryScheme<T> &scheme, int p);
     void project(int p, int q);
@@ -70,6 +72,10 @@ public:
     void saveJson(const std::string &path) const;
     void saveTxt(const std::string &path) const;
     void copy(const BinaryScheme &scheme);
+    void pack(std::ostream &os) const;
+    bool unpack(std::istream &is);
+    void packTerms(std::vector<uint8_t> &blob) const;
+    bool unpackTerms(const uint8_t *blob, size_t size);
 
     bool validate() const;
     bool validateParallel() const;
@@ -80,6 +86,12 @@ public:
     bool canLift(int steps) const;
 protected:
     void initFlips();
+    void initBuckets();
+    void initFingerprint();
+    SchemeFingerprint getTermFingerprint(int index) const;
+    uint64_t getFlipKey(int i, int index) const;
+    void updateFlips(int index);
+    void updateFlips(int i, int index);
     void removeZeroes();
     void removeAt(int index);
     void addTriplet(int i, int j, int k, const T &u, const T &v, const T &w);
@@ -96,8 +108,9 @@ protected:
 
 
     bool validateDimensions() const;
-    bool validateEquation(int i, int j, int k) const;
-    void saveMatrix(std::ofstream &f, std::string name, const std::vector<T> &vectors, int size) const;
+    size_t getPackedSize() const;
+    BrentValidator getValidator() const;
+    void saveMatrix(std::ofstream &f, std::string name, int matrix) const;
 
     BinarySolver getJakobian() const;
 };
@@ -127,9 +140,10 @@ bool BinaryScheme<T>::initializeNaive(int n1, int n2, int n3) {
     if (!validateDimensions())
         return false;
 
-    uvw[0].clear();
-    uvw[1].clear();
-    uvw[2].clear();
+    for (int i = 0; i < 3; i++) {
+        uvw[i].clear();
+        uvw[i].reserve(rank);
+    }
 
     for (int i = 0; i < n1; i++) {
         for (int j = 0; j < n3; j++) {
@@ -142,6 +156,7 @@ bool BinaryScheme<T>::initializeNaive(int n1, int n2, int n3) {
     }
 
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -176,6 +191,8 @@ bool BinaryScheme<T>::read(std::istream &is, bool checkCorrectness) {
         return false;
 
     for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
         for (int index = 0; index < rank; index++) {
             T vector = 0;
             for (int j = 0; j < elements[i]; j++) {
@@ -192,6 +209,7 @@ bool BinaryScheme<T>::read(std::istream &is, bool checkCorrectness) {
         return false;
 
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -282,13 +300,16 @@ std::vector<std::vector<int>> BinaryScheme<T>::getExpressionsW() const {
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryFlip(std::mt19937 &generator) {
+bool BinaryScheme<T>::tryFlip(RandomGenerator &generator) {
     size_t size = flips[0].size() + flips[1].size() + flips[2].size();
 
-    if (!size)
+    if (!size) {
+        counters.failedFlips++;
         return false;
+    }
 
     size_t index = generator() % size;
+    counters.flipCandidates++;
 
     int i, j, k;
 
@@ -320,11 +341,12 @@ bool BinaryScheme<T>::tryFlip(std::mt19937 &generator) {
         std::swap(index1, index2);
 
     flip(i, j, k, index1, index2);
+    counters.flips++;
     return true;
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryPlus(std::mt19937 &generator) {
+bool BinaryScheme<T>::tryPlus(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1 = distribution(generator);
     int index2 = distribution(generator);
@@ -338,11 +360,12 @@ bool BinaryScheme<T>::tryPlus(std::mt19937 &generator) {
     std::shuffle(permutation, permutation + 3, generator);
 
     plus(permutation[0], permutation[1], permutation[2], index1, index2, ijkDistribution(generator));
+    counters.plus++;
     return true;
 }
 
 template <typename T>
-bool BinaryScheme<T>::trySplit(std::mt19937 &generator) {
+bool BinaryScheme<T>::trySplit(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1, index2, i;
 
@@ -353,13 +376,16 @@ bool BinaryScheme<T>::trySplit(std::mt19937 &generator) {
     } while (index1 == index2 || uvw[i][index1] == uvw[i][index2]);
 
     split(i, (i + 1) % 3, (i + 2) % 3, index1, index2);
+    counters.splits++;
     return true;
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryExpand(std::mt19937 &generator) {
-    if (rank >= dimension[0] * dimension[1] * dimension[2])
+bool BinaryScheme<T>::tryExpand(RandomGenerator &generator) {
+    if (rank >= dimension[0] * dimension[1] * dimension[2]) {
+        counters.failedExpands++;
         return false;
+    }
 
     if (boolDistribution(generator))
         return tryPlus(generator);
@@ -368,7 +394,7 @@ bool BinaryScheme<T>::tryExpand(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool BinaryScheme<T>::trySandwiching(std::mt19937 &generator) {
+bool BinaryScheme<T>::trySandwiching(RandomGenerator &generator) {
     BinaryMatrix u(dimension[0], dimension[0]);
     BinaryMatrix v(dimension[1], dimension[1]);
     BinaryMatrix w(dimension[2], dimension[2]);
@@ -413,6 +439,8 @@ bool BinaryScheme<T>::trySandwiching(std::mt19937 &generator) {
     }
 
     initFlips();
+    initFingerprint();
+    counters.sandwichings++;
     return true;
 }
 
@@ -424,11 +452,13 @@ bool BinaryScheme<T>::tryReduce() {
 
         if (uvw[1][index1] == uvw[1][index2]) {
             reduce(2, index1, index2);
+            counters.reductions++;
             return true;
         }
 
         if (uvw[2][index1] == uvw[2][index2]) {
             reduce(1, index1, index2);
+            counters.reductions++;
             return true;
         }
     }
@@ -439,6 +469,7 @@ bool BinaryScheme<T>::tryReduce() {
 
         if (uvw[2][index1] == uvw[2][index2]) {
             reduce(0, index1, index2);
+            counters.reductions++;
             return true;
         }
     }
@@ -469,7 +500,7 @@ bool BinaryScheme<T>::check2Reduce() const {
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryProject(std::mt19937 &generator, int minN) {
+bool BinaryScheme<T>::tryProject(RandomGenerator &generator, int minN) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -490,7 +521,7 @@ bool BinaryScheme<T>::tryProject(std::mt19937 &generator, int minN) {
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank) {
+bool BinaryScheme<T>::tryExtend(RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -505,7 +536,7 @@ bool BinaryScheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank)
 }
 
 template <typename T>
-bool BinaryScheme<T>::tryMerge(const BinaryScheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank) {
+bool BinaryScheme<T>::tryMerge(const BinaryScheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -562,7 +593,7 @@ void BinaryScheme<T>::setSizes(int n1, int n2, int n3) {
 }
 
 template <typename T>
-void BinaryScheme<T>::swapSizes(std::mt19937 &generator) {
+void BinaryScheme<T>::swapSizes(RandomGenerator &generator) {
     int p1, p2;
 
     do {
@@ -617,6 +648,7 @@ void BinaryScheme<T>::swapSizes(int p1, int p2) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -681,6 +713,7 @@ void BinaryScheme<T>::merge(const BinaryScheme<T> &scheme, int p) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -694,6 +727,7 @@ void BinaryScheme<T>::project(int p, int q) {
 
     removeZeroes();
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -738,6 +772,7 @@ void BinaryScheme<T>::extend(int p) {
         elements[i] = dimension[i] * dimension[(i + 1) % 3];
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -784,6 +819,7 @@ void BinaryScheme<T>::product(const BinaryScheme<T> &scheme2) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -796,11 +832,11 @@ void BinaryScheme<T>::saveJson(const std::string &path) const {
     f << "    \"z2\": true," << std::endl;
     f << "    \"complexity\": " << getComplexity() << "," << std::endl;
 
-    saveMatrix(f, "u", uvw[0], elements[0]);
+    saveMatrix(f, "u", 0);
     f << "," << std::endl;
-    saveMatrix(f, "v", uvw[1], elements[1]);
+    saveMatrix(f, "v", 1);
     f << "," << std::endl;
-    saveMatrix(f, "w", uvw[2], elements[2]);
+    saveMatrix(f, "w", 2);
     f << std::endl;
     f << "}" << std::endl;
 
@@ -827,41 +863,111 @@ void BinaryScheme<T>::saveTxt(const std::string &path) const {
 template <typename T>
 void BinaryScheme<T>::copy(const BinaryScheme &scheme) {
     rank = scheme.rank;
+    fingerprint = scheme.fingerprint;
+    uvw.copy(scheme.uvw);
 
     for (int i = 0; i < 3; i++) {
         dimension[i] = scheme.dimension[i];
         elements[i] = scheme.elements[i];
-        uvw[i].clear();
+        flips[i] = scheme.flips[i];
+        buckets[i] = scheme.buckets[i];
+    }
+}
+
+template <typename T>
+void BinaryScheme<T>::pack(std::ostream &os) const {
+    packBase(os);
+    writeBinary(os, uint32_t(sizeof(T)));
+
+    for (int i = 0; i < 3; i++)
+        uvw.pack(os, i);
+}
 
+template <typename T>
+bool BinaryScheme<T>::unpack(std::istream &is) {
+    uint32_t vectorSize;
+    if (!unpackBase(is) || !readBinary(is, vectorSize) || vectorSize != sizeof(T) || !validateDimensions())
+        return false;
+
+    uvw.reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
+    for (int i = 0; i < 3; i++)
+        if (!uvw.unpack(is, i, rank))
+            return false;
+
+    initBuckets();
+    initFingerprint();
+    return true;
+}
+
+template <typename T>
+void BinaryScheme<T>::packTerms(std::vector<uint8_t> &blob) const {
+    size_t position = 0;
+
+    blob.clear();
+    blob.reserve(getPackedSize());
+    writeBlob(blob, dimension);
+    writeBlob(blob, rank);
+
+    for (int i = 0; i < 3; i++)
         for (int index = 0; index < rank; index++)
-            uvw[i].push_back(scheme.uvw[i][index]);
+            writeBlobBits(blob, position, uvw[i][index], elements[i]);
+}
+
+template <typename T>
+bool BinaryScheme<T>::unpackTerms(const uint8_t *blob, size_t size) {
+    size_t position = 0;
+
+    if (size < sizeof(dimension) + sizeof(rank))
+        return false;
+
+    readBlob(blob, dimension);
+    readBlob(blob, rank);
+
+    for (int i = 0; i < 3; i++)
+        elements[i] = dimension[i] * dimension[(i + 1) % 3];
+
+    if (rank < 0 || !validateDimensions() || size != getPackedSize())
+        return false;
+
+    for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+        uvw[i].resize(rank);
+
+        for (int index = 0; index < rank; index++)
+            readBlobBits(blob, position, uvw[i][index], elements[i]);
     }
 
     initFlips();
+    initFingerprint();
+    return true;
 }
 
 template <typename T>
-bool BinaryScheme<T>::validate() const {
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                if (!validateEquation(i, j, k))
-                    return false;
+size_t BinaryScheme<T>::getPackedSize() const {
+    return sizeof(dimension) + sizeof(rank) + (size_t(rank) * (elements[0] + elements[1] + elements[2]) + 7) / 8;
+}
 
-    return true;
+template <typename T>
+bool BinaryScheme<T>::validate() const {
+    return getValidator().validate();
 }
 
 template <typename T>
 bool BinaryScheme<T>::validateParallel() const {
-    bool valid = true;
+    return getValidator().validateParallel();
+}
 
-    #pragma omp parallel for collapse(3) reduction(&&: valid) schedule(dynamic, 32)
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                valid = valid && validateEquation(i, j, k);
+template <typename T>
+BrentValidator BinaryScheme<T>::getValidator() const {
+    BrentValidator validator(dimension[0], dimension[1], dimension[2], rank, 2);
 
-    return valid;
+    for (int i = 0; i < 3; i++)
+        for (int index = 0; index < rank; index++)
+            for (int j = 0; j < elements[i]; j++)
+                validator.set(i, index, j, int((uvw[i][index] >> j) & 1));
+
+    return validator;
 }
 
 template <typename T>
@@ -908,16 +1014,73 @@ bool BinaryScheme<T>::canLift(int steps) const {
 
 template <typename T>
 void BinaryScheme<T>::initFlips() {
+    initBuckets();
+
     for (int i = 0; i < 3; i++) {
         flips[i].clear();
 
-        for (int index1 = 0; index1 < rank; index1++)
-            for (int index2 = index1 + 1; index2 < rank; index2++)
-                if (uvw[i][index1] == uvw[i][index2])
-                    flips[i].add(index1, index2);
+        for (int index = 0; index < rank; index++) {
+            buckets[i].collect(getFlipKey(i, index), bucketIndices);
+
+            for (uint32_t other : bucketIndices)
+                if (int(other) > index && uvw[i][other] == uvw[i][index])
+                    flips[i].add(index, other);
+        }
+    }
+}
+
+template <typename T>
+void BinaryScheme<T>::initBuckets() {
+    for (int i = 0; i < 3; i++) {
+        buckets[i].reset(rank);
+
+        for (int index = 0; index < rank; index++)
+            buckets[i].add(getFlipKey(i, index), index);
     }
 }
 
+template <typename T>
+void BinaryScheme<T>::initFingerprint() {
+    fingerprint = getDimensionFingerprint();
+
+    for (int index = 0; index < rank; index++)
+        fingerprint += getTermFingerprint(index);
+}
+
+template <typename T>
+SchemeFingerprint BinaryScheme<T>::getTermFingerprint(int index) const {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < 3; i++)
+        hash = foldBits(hash, uvw[i][index]);
+
+    return SchemeFingerprint(hash);
+}
+
+template <typename T>
+uint64_t BinaryScheme<T>::getFlipKey(int i, int index) const {
+    return hashBits(uvw[i][index]);
+}
+
+template <typename T>
+void BinaryScheme<T>::updateFlips(int index) {
+    for (int i = 0; i < 3; i++)
+        updateFlips(i, index);
+}
+
+template <typename T>
+void BinaryScheme<T>::updateFlips(int i, int index) {
+    uint64_t key = getFlipKey(i, index);
+
+    flips[i].remove(index);
+    buckets[i].add(key, index);
+    buckets[i].collect(key, bucketIndices);
+
+    for (uint32_t other : bucketIndices)
+        if (int(other) != index && uvw[i][other] == uvw[i][index])
+            flips[i].add(index, other);
+}
+
 template <typename T>
 void BinaryScheme<T>::removeZeroes() {
     for (int index = 0; index < rank; index++)
@@ -927,17 +1090,21 @@ void BinaryScheme<T>::removeZeroes() {
 
 template <typename T>
 void BinaryScheme<T>::removeAt(int index) {
+    fingerprint -= getTermFingerprint(index);
     rank--;
 
-    if (index != rank) {
-        uvw[0][index] = uvw[0].back();
-        uvw[1][index] = uvw[1].back();
-        uvw[2][index] = uvw[2].back();
-    }
+    for (int i = 0; i < 3; i++) {
+        flips[i].remove(index);
+        buckets[i].remove(index);
 
-    uvw[0].pop_back();
-    uvw[1].pop_back();
-    uvw[2].pop_back();
+        if (index != rank) {
+            flips[i].move(rank, index);
+            buckets[i].move(rank, index);
+            uvw[i][index] = uvw[i].back();
+        }
+
+        uvw[i].pop_back();
+    }
 }
 
 template <typename T>
@@ -946,6 +1113,7 @@ void BinaryScheme<T>::addTriplet(int i, int j, int k, const T &u, const T &v, co
     uvw[j].push_back(v);
     uvw[k].push_back(w);
     rank++;
+    fingerprint += getTermFingerprint(rank - 1);
 }
 
 template <typename T>
@@ -1024,33 +1192,64 @@ void BinaryScheme<T>::addRow(int matrix) {
 
 template <typename T>
 void BinaryScheme<T>::flip(int i, int j, int k, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
+    fingerprint -= getTermFingerprint(index2);
+
     uvw[j][index1] ^= uvw[j][index2];
     uvw[k][index2] ^= uvw[k][index1];
 
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
     flips[j].remove(index1);
     flips[k].remove(index2);
 
     if (!uvw[j][index1] || !uvw[k][index2]) {
+        updateFlips(j, index1);
+        updateFlips(k, index2);
         removeZeroes();
-        initFlips();
         return;
     }
 
-    for (int index = 0; index < rank; index++) {
-        if (index != index1 && uvw[j][index] == uvw[j][index1]) {
-            if (checkFlipReduce(i, k, index, index1))
-                return;
+    reduceCandidates.clear();
+
+    uint64_t key1 = getFlipKey(j, index1);
+    buckets[j].add(key1, index1);
+    buckets[j].collect(key1, bucketIndices);
 
+    for (uint32_t index : bucketIndices) {
+        if (int(index) != index1 && uvw[j][index] == uvw[j][index1]) {
+            reduceCandidates.push_back(index * 2);
             flips[j].add(index1, index);
         }
+    }
 
-        if (index != index2 && uvw[k][index] == uvw[k][index2]) {
-            if (checkFlipReduce(i, j, index, index2))
-                return;
+    uint64_t key2 = getFlipKey(k, index2);
+    buckets[k].add(key2, index2);
+    buckets[k].collect(key2, bucketIndices);
 
+    for (uint32_t index : bucketIndices) {
+        if (int(index) != index2 && uvw[k][index] == uvw[k][index2]) {
+            reduceCandidates.push_back(index * 2 + 1);
             flips[k].add(index2, index);
         }
     }
+
+    std::sort(reduceCandidates.begin(), reduceCandidates.end());
+
+    for (int candidate : reduceCandidates) {
+        int index = candidate / 2;
+
+        if (candidate % 2 == 0 && checkFlipReduce(i, k, index, index1)) {
+            counters.flipReductions++;
+            return;
+        }
+
+        if (candidate % 2 == 1 && checkFlipReduce(i, j, index, index2)) {
+            counters.flipReductions++;
+            return;
+        }
+    }
 }
 
 template <typename T>
@@ -1067,6 +1266,9 @@ void BinaryScheme<T>::plus(int i, int j, int k, int index1, int index2, int vari
     const T b = b1 ^ b2;
     const T c = c1 ^ c2;
 
+    fingerprint -= getTermFingerprint(index1);
+    fingerprint -= getTermFingerprint(index2);
+
     if (variant == 0) {
         uvw[j][index1] = b;
         uvw[i][index2] = a;
@@ -1083,10 +1285,15 @@ void BinaryScheme<T>::plus(int i, int j, int k, int index1, int index2, int vari
         addTriplet(i, j, k, a2, b, c1);
     }
 
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
+    updateFlips(index1);
+    updateFlips(index2);
+    updateFlips(rank - 1);
+
     if (!a || !b || !c)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
@@ -1096,23 +1303,27 @@ void BinaryScheme<T>::split(int i, int j, int k, int index1, int index2) {
     const T w = uvw[k][index1];
 
     addTriplet(i, j, k, u, v, w);
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] = uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
 
+    updateFlips(index1);
+    updateFlips(rank - 1);
     removeZeroes();
-    initFlips();
 }
 
 template <typename T>
 void BinaryScheme<T>::reduce(int i, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] ^= uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
     bool isZero = !uvw[i][index1];
 
+    updateFlips(i, index1);
     removeAt(index2);
 
     if (isZero)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
@@ -1214,34 +1425,16 @@ bool BinaryScheme<T>::validateDimensions() const {
 }
 
 template <typename T>
-bool BinaryScheme<T>::validateEquation(int i, int j, int k) const {
-    int i1 = i / dimension[1];
-    int i2 = i % dimension[1];
-    int j1 = j / dimension[2];
-    int j2 = j % dimension[2];
-    int k1 = k / dimension[0];
-    int k2 = k % dimension[0];
-
-    bool target = (i2 == j1) && (i1 == k2) && (j2 == k1);
-    bool equation = false;
-
-    for (int index = 0; index < rank; index++)
-        equation ^= ((uvw[0][index] >> i) & 1) && ((uvw[1][index] >> j) & 1) && ((uvw[2][index] >> k) & 1);
-
-    return equation == target;
-}
-
-template <typename T>
-void BinaryScheme<T>::saveMatrix(std::ofstream &f, std::string name, const std::vector<T> &vectors, int size) const {
+void BinaryScheme<T>::saveMatrix(std::ofstream &f, std::string name, int matrix) const {
     f << "    \"" << name << "\": [" << std::endl;
 
-    for (size_t index = 0; index < vectors.size(); index++) {
+    for (int index = 0; index < rank; index++) {
         f << "        [";
 
-        for (int i = 0; i < size; i++)
-            f << (i > 0 ? ", " : "") << (int)((vectors[index] >> i) & 1);
+        for (int i = 0; i < elements[matrix]; i++)
+            f << (i > 0 ? ", " : "") << (int)((uvw[matrix][index] >> i) & 1);
 
-        f << "]" << (index < vectors.size() - 1 ? "," : "") << std::endl;
+        f << "]" << (index < rank - 1 ? "," : "") << std::endl;
     }
 
     f << "    ]";
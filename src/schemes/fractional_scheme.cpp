@@ -73,6 +73,9 @@ bool FractionalScheme::reconstruct(int n1, int n2, int n3, int rank, const std::
 }
 
 bool FractionalScheme::validate() const {
+    if (isTernary())
+        return getValidator().validate();
+
     for (int i = 0; i < elements[0]; i++)
         for (int j = 0; j < elements[1]; j++)
             for (int k = 0; k < elements[2]; k++)
@@ -83,6 +86,9 @@ bool FractionalScheme::validate() const {
 }
 
 bool FractionalScheme::validateParallel() const {
+    if (isTernary())
+        return getValidator().validateParallel();
+
     bool valid = true;
 
     #pragma omp parallel for collapse(3) reduction(&&: valid) schedule(dynamic, 32)
@@ -477,7 +483,7 @@ std::string FractionalScheme::getTypeInvariant() const {
     return invariants.getType();
 }
 
-bool FractionalScheme::tryFlip(std::mt19937 &generator) {
+bool FractionalScheme::tryFlip(RandomGenerator &generator) {
     size_t sizePos = flips[0].size() + flips[1].size() + flips[2].size();
     size_t sizeNeg = flipsNeg[0].size() + flipsNeg[1].size() + flipsNeg[2].size();
     size_t size = sizePos + sizeNeg;
@@ -500,7 +506,7 @@ bool FractionalScheme::tryFlip(std::mt19937 &generator) {
     return true;
 }
 
-void FractionalScheme::plus(std::mt19937 &generator) {
+void FractionalScheme::plus(RandomGenerator &generator) {
     int index1 = generator() % rank;
     int index2 = generator() % rank;
 
@@ -515,7 +521,7 @@ void FractionalScheme::plus(std::mt19937 &generator) {
     plus(permutation[0], permutation[1], permutation[2], index1, index2, generator() % 3);
 }
 
-void FractionalScheme::split(std::mt19937 &generator) {
+void FractionalScheme::split(RandomGenerator &generator) {
     int index1, index2, i;
 
     do {
@@ -527,7 +533,7 @@ void FractionalScheme::split(std::mt19937 &generator) {
     split(i, (i + 1) % 3, (i + 2) % 3, index1, index2);
 }
 
-void FractionalScheme::expand(std::mt19937 &generator) {
+void FractionalScheme::expand(RandomGenerator &generator) {
     if (generator() % 2) {
         plus(generator);
     }
@@ -536,7 +542,7 @@ void FractionalScheme::expand(std::mt19937 &generator) {
     }
 }
 
-void FractionalScheme::split(std::mt19937 &generator, const std::vector<Fraction> &values) {
+void FractionalScheme::split(RandomGenerator &generator, const std::vector<Fraction> &values) {
     int permutation[3] = {0, 1, 2};
     std::shuffle(permutation, permutation + 3, generator);
 
@@ -855,6 +861,17 @@ void FractionalScheme::addTriplet(int i, int j, int k, const std::vector<Fractio
     rank++;
 }
 
+BrentValidator FractionalScheme::getValidator() const {
+    BrentValidator validator(dimension[0], dimension[1], dimension[2], rank, 0);
+
+    for (int i = 0; i < 3; i++)
+        for (int index = 0; index < rank; index++)
+            for (int j = 0; j < elements[i]; j++)
+                validator.set(i, index, j, uvw[i][index * elements[i] + j].numerator());
+
+    return validator;
+}
+
 bool FractionalScheme::validateEquation(int i, int j, int k) const {
     int i1 = i / dimension[1];
     int i2 = i % dimension[1];
@@ -918,7 +935,7 @@ bool FractionalScheme::isPositiveFirstNonZero(int p, int index) const {
     return true;
 }
 
-void FractionalScheme::selectFlip(FlipSet *flips, size_t index, int &i, int &j, int &k, int &index1, int &index2, std::mt19937 &generator) {
+void FractionalScheme::selectFlip(FlipSet *flips, size_t index, int &i, int &j, int &k, int &index1, int &index2, RandomGenerator &generator) {
     if (index < flips[0].size()) {
         i = 0;
         j = 1;
@@ -64,11 +64,11 @@ public:
 
     std::string getTypeInvariant() const;
 
-    bool tryFlip(std::mt19937 &generator);
-    void plus(std::mt19937 &generator);
-    void split(std::mt19937 &generator);
-    void expand(std::mt19937 &generator);
-    void split(std::mt19937 &generator, const std::vector<Fraction> &values);
+    bool tryFlip(RandomGenerator &generator);
+    void plus(RandomGenerator &generator);
+    void split(RandomGenerator &generator);
+    void expand(RandomGenerator &generator);
+    void split(RandomGenerator &generator, const std::vector<Fraction> &values);
     void sandwiching(const Matrix &u, const Matrix &v, const Matrix &w, const Matrix &u1, const Matrix &v1, const Matrix &w1);
     void scale(int index, const Fraction &alpha, const Fraction &beta, const Fraction &gamma);
     void fixFractions();
@@ -89,6 +89,7 @@ private:
     void addTriplet(int i, int j, int k, const std::vector<Fraction> &u, const std::vector<Fraction> &v, const std::vector<Fraction> &w);
 
     bool validateEquation(int i, int j, int k) const;
+    BrentValidator getValidator() const;
     bool reconstructValue(int64_t a, int64_t mod, int64_t bound, Fraction &fraction) const;
 
     bool isEqualMatrices(int p, int index1, int index2) const;
@@ -98,7 +99,7 @@ private:
     bool isLinearlyDependentMatrices(int p, int index1, int index2) const;
     bool isPositiveFirstNonZero(int p, int index) const;
 
-    void selectFlip(FlipSet *flips, size_t index, int &i, int &j, int &k, int &index1, int &index2, std::mt19937 &generator);
+    void selectFlip(FlipSet *flips, size_t index, int &i, int &j, int &k, int &index1, int &index2, RandomGenerator &generator);
     void flip(int i, int j, int k, int index1, int index2, bool inverse);
     void plus(int i, int j, int k, int index1, int index2, int variant);
     void split(int i, int j, int k, int index1, int index2);
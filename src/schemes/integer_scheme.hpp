@@ -35,11 +35,11 @@ public:
     std::string getRing() const;
     int getAvailableFlips() const;
 
-    bool tryFlip(std::mt19937 &generator);
-    bool tryPlus(std::mt19937 &generator);
-    bool trySplit(std::mt19937 &generator);
-    bool tryExpand(std::mt19937 &generator);
-    bool trySandwiching(std::mt19937 &generator) { return false; }
+    bool tryFlip(RandomGenerator &generator);
+    bool tryPlus(RandomGenerator &generator);
+    bool trySplit(RandomGenerator &generator);
+    bool tryExpand(RandomGenerator &generator);
+    bool trySandwiching(RandomGenerator &generator) { return false; }
     bool tryReduce();
 
     void saveJson(const std::string &path) const;
@@ -178,7 +178,7 @@ int IntegerScheme<T>::getAvailableFlips() const {
 }
 
 template <typename T>
-bool IntegerScheme<T>::tryFlip(std::mt19937 &generator) {
+bool IntegerScheme<T>::tryFlip(RandomGenerator &generator) {
     size_t size = flips[0].size() + flips[1].size() + flips[2].size();
 
     if (!size)
@@ -243,7 +243,7 @@ bool IntegerScheme<T>::tryFlip(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool IntegerScheme<T>::tryPlus(std::mt19937 &generator) {
+bool IntegerScheme<T>::tryPlus(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1 = distribution(generator);
     int index2 = distribution(generator);
@@ -260,7 +260,7 @@ bool IntegerScheme<T>::tryPlus(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool IntegerScheme<T>::trySplit(std::mt19937 &generator) {
+bool IntegerScheme<T>::trySplit(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1, index2, i;
 
@@ -282,7 +282,7 @@ bool IntegerScheme<T>::trySplit(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool IntegerScheme<T>::tryExpand(std::mt19937 &generator) {
+bool IntegerScheme<T>::tryExpand(RandomGenerator &generator) {
     if (rank >= dimension[0] * dimension[1] * dimension[2])
         return false;
 
@@ -1,8 +1,10 @@
 #include "mod3_scheme.hpp"
-#include "../entities/uint256_t.h"
+#include "../entities/bit_vector.hpp"
 
 template class Mod3Scheme<uint16_t>;
 template class Mod3Scheme<uint32_t>;
 template class Mod3Scheme<uint64_t>;
 template class Mod3Scheme<__uint128_t>;
 template class Mod3Scheme<uint256_t>;
+template class Mod3Scheme<uint512_t>;
+template class Mod3Scheme<uint1024_t>;
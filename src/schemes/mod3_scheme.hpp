@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "../entities/mod3_vector.hpp"
+#include "../entities/scheme_arena.hpp"
 #include "../entities/ranks.h"
 #include "../entities/invariants_builder.h"
 #include "../algebra/matrix.h"
@@ -20,9 +21,10 @@
 template <typename T>
 class Mod3Scheme : public BaseScheme {
 protected:
-    std::vector<Mod3Vector<T>> uvw[3];
+    SchemeArena<Mod3Vector<T>> uvw;
 private:
     FlipSet flipsNeg[3];
+    std::vector<int> reduceCandidates;
 public:
     Mod3Scheme();
     Mod3Scheme(const Mod3Scheme<T> &scheme);
@@ -41,17 +43,17 @@ public:
     std::vector<std::vector<int>> getExpressionsV() const;
     std::vector<std::vector<int>> getExpressionsW() const;
 
-    bool tryFlip(std::mt19937 &generator);
-    bool tryPlus(std::mt19937 &generator);
-    bool trySplit(std::mt19937 &generator);
-    bool tryExpand(std::mt19937 &generator);
-    bool trySandwiching(std::mt19937 &generator);
+    bool tryFlip(RandomGenerator &generator);
+    bool tryPlus(RandomGenerator &generator);
+    bool trySplit(RandomGenerator &generator);
+    bool tryExpand(RandomGenerator &generator);
+    bool trySandwiching(RandomGenerator &generator);
     bool tryReduce();
     bool check2Reduce() const;
 
-    bool tryProject(std::mt19937 &generator, int minN);
-    bool tryExtend(std::mt19937 &generator, int maxN, int maxRank);
-    bool tryMerge(const Mod3Scheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank);
+    bool tryProject(RandomGenerator &generator, int minN);
+    bool tryExtend(RandomGenerator &generator, int maxN, int maxRank);
+    bool tryMerge(const Mod3Scheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank);
     bool tryProduct(const Mod3Scheme<T> &scheme, int maxN, int maxRank);
 
     bool isValidProject(int p, int minN) const;
@@ -61,7 +63,7 @@ public:
 
     void fixSizes();
     void setSizes(int n1, int n2, int n3);
-    void swapSizes(std::mt19937 &generator);
+    void swapSizes(RandomGenerator &generator);
     void swapSizes(int p1, int p2);
     void merge(const Mod3Scheme<T> &scheme, int p);
     void project(int p, int q);
@@ -71,6 +73,10 @@ public:
     void saveJson(const std::string &path) const;
     void saveTxt(const std::string &path) const;
     void copy(const Mod3Scheme &scheme);
+    void pack(std::ostream &os) const;
+    bool unpack(std::istream &is);
+    void packTerms(std::vector<uint8_t> &blob) const;
+    bool unpackTerms(const uint8_t *blob, size_t size);
 
     bool validate() const;
     bool validateParallel() const;
@@ -81,6 +87,12 @@ public:
     bool canLift(int steps) const;
 private:
     void initFlips();
+    void initBuckets();
+    void initFingerprint();
+    SchemeFingerprint getTermFingerprint(int index) const;
+    uint64_t getFlipKey(int i, int index) const;
+    void updateFlips(int index);
+    void updateFlips(int i, int index);
     void removeZeroes();
     void removeAt(int index);
     void addTriplet(int i, int j, int k, const Mod3Vector<T> &u, const Mod3Vector<T> &v, const Mod3Vector<T> &w);
@@ -99,9 +111,10 @@ private:
 
 
     bool validateDimensions() const;
-    bool validateEquation(int i, int j, int k) const;
+    size_t getPackedSize() const;
+    BrentValidator getValidator() const;
     void normalize();
-    void saveMatrix(std::ofstream &f, std::string name, const std::vector<Mod3Vector<T>> &vectors) const;
+    void saveMatrix(std::ofstream &f, std::string name, int matrix) const;
 
     Mod3Solver getJakobian() const;
 };
@@ -131,9 +144,10 @@ bool Mod3Scheme<T>::initializeNaive(int n1, int n2, int n3) {
     if (!validateDimensions())
         return false;
 
-    uvw[0].clear();
-    uvw[1].clear();
-    uvw[2].clear();
+    for (int i = 0; i < 3; i++) {
+        uvw[i].clear();
+        uvw[i].reserve(rank);
+    }
 
     for (int i = 0; i < n1; i++) {
         for (int j = 0; j < n3; j++) {
@@ -146,6 +160,7 @@ bool Mod3Scheme<T>::initializeNaive(int n1, int n2, int n3) {
     }
 
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -180,6 +195,8 @@ bool Mod3Scheme<T>::read(std::istream &is, bool checkCorrectness) {
         return false;
 
     for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
         for (int index = 0; index < rank; index++) {
             Mod3Vector<T> vector(elements[i]);
             is >> vector;
@@ -191,6 +208,7 @@ bool Mod3Scheme<T>::read(std::istream &is, bool checkCorrectness) {
         return false;
 
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -291,15 +309,18 @@ std::vector<std::vector<int>> Mod3Scheme<T>::getExpressionsW() const {
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryFlip(std::mt19937 &generator) {
+bool Mod3Scheme<T>::tryFlip(RandomGenerator &generator) {
     size_t sizePos = flips[0].size() + flips[1].size() + flips[2].size();
     size_t sizeNeg = flipsNeg[0].size() + flipsNeg[1].size() + flipsNeg[2].size();
     size_t size = sizePos + sizeNeg;
 
-    if (!size)
+    if (!size) {
+        counters.failedFlips++;
         return false;
+    }
 
     size_t index = generator() % size;
+    counters.flipCandidates++;
     bool pos = index < sizePos;
 
     int i, j, k;
@@ -350,11 +371,12 @@ bool Mod3Scheme<T>::tryFlip(std::mt19937 &generator) {
         std::swap(index1, index2);
 
     flip(i, j, k, index1, index2, pos);
+    counters.flips++;
     return true;
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryPlus(std::mt19937 &generator) {
+bool Mod3Scheme<T>::tryPlus(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1 = distribution(generator);
     int index2 = distribution(generator);
@@ -368,11 +390,12 @@ bool Mod3Scheme<T>::tryPlus(std::mt19937 &generator) {
     std::shuffle(permutation, permutation + 3, generator);
 
     plus(permutation[0], permutation[1], permutation[2], index1, index2, ijkDistribution(generator));
+    counters.plus++;
     return true;
 }
 
 template <typename T>
-bool Mod3Scheme<T>::trySplit(std::mt19937 &generator) {
+bool Mod3Scheme<T>::trySplit(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1, index2, i;
 
@@ -383,13 +406,16 @@ bool Mod3Scheme<T>::trySplit(std::mt19937 &generator) {
     } while (index1 == index2 || uvw[i][index1] == uvw[i][index2]);
 
     split(i, (i + 1) % 3, (i + 2) % 3, index1, index2);
+    counters.splits++;
     return true;
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryExpand(std::mt19937 &generator) {
-    if (rank >= dimension[0] * dimension[1] * dimension[2])
+bool Mod3Scheme<T>::tryExpand(RandomGenerator &generator) {
+    if (rank >= dimension[0] * dimension[1] * dimension[2]) {
+        counters.failedExpands++;
         return false;
+    }
 
     if (boolDistribution(generator))
         return tryPlus(generator);
@@ -398,7 +424,7 @@ bool Mod3Scheme<T>::tryExpand(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool Mod3Scheme<T>::trySandwiching(std::mt19937 &generator) {
+bool Mod3Scheme<T>::trySandwiching(RandomGenerator &generator) {
     Matrix u(dimension[0], dimension[0]);
     Matrix v(dimension[1], dimension[1]);
     Matrix w(dimension[2], dimension[2]);
@@ -419,8 +445,10 @@ bool Mod3Scheme<T>::trySandwiching(std::mt19937 &generator) {
         w.random(0, 2, 1, generator);
     } while (!w.invertible(w1));
 
-    if (!u1.toRing(3) || !v1.toRing(3) || !w1.toRing(3))
+    if (!u1.toRing(3) || !v1.toRing(3) || !w1.toRing(3)) {
+        counters.rejectedSandwichings++;
         return false;
+    }
 
     for (int index = 0; index < rank; index++) {
         Matrix mu(dimension[0], dimension[1]);
@@ -455,6 +483,8 @@ bool Mod3Scheme<T>::trySandwiching(std::mt19937 &generator) {
     }
 
     initFlips();
+    initFingerprint();
+    counters.sandwichings++;
     return true;
 }
 
@@ -464,38 +494,50 @@ bool Mod3Scheme<T>::tryReduce() {
         int index1 = flips[0].index1(i);
         int index2 = flips[0].index2(i);
 
-        if (reduce(2, index1, index2, uvw[1][index1].compare(uvw[1][index2])))
+        if (reduce(2, index1, index2, uvw[1][index1].compare(uvw[1][index2]))) {
+            counters.reductions++;
             return true;
+        }
 
-        if (reduce(1, index1, index2, uvw[2][index1].compare(uvw[2][index2])))
+        if (reduce(1, index1, index2, uvw[2][index1].compare(uvw[2][index2]))) {
+            counters.reductions++;
             return true;
+        }
     }
 
     for (size_t i = 0; i < flips[1].size(); i++) {
         int index1 = flips[1].index1(i);
         int index2 = flips[1].index2(i);
 
-        if (reduce(0, index1, index2, uvw[2][index1].compare(uvw[2][index2])))
+        if (reduce(0, index1, index2, uvw[2][index1].compare(uvw[2][index2]))) {
+            counters.reductions++;
             return true;
+        }
     }
 
     for (size_t i = 0; i < flipsNeg[0].size(); i++) {
         int index1 = flipsNeg[0].index1(i);
         int index2 = flipsNeg[0].index2(i);
 
-        if (reduce(2, index1, index2, -uvw[1][index1].compare(uvw[1][index2])))
+        if (reduce(2, index1, index2, -uvw[1][index1].compare(uvw[1][index2]))) {
+            counters.reductions++;
             return true;
+        }
 
-        if (reduce(1, index1, index2, -uvw[2][index1].compare(uvw[2][index2])))
+        if (reduce(1, index1, index2, -uvw[2][index1].compare(uvw[2][index2]))) {
+            counters.reductions++;
             return true;
+        }
     }
 
     for (size_t i = 0; i < flipsNeg[1].size(); i++) {
         int index1 = flipsNeg[1].index1(i);
         int index2 = flipsNeg[1].index2(i);
 
-        if (reduce(0, index1, index2, -uvw[2][index1].compare(uvw[2][index2])))
+        if (reduce(0, index1, index2, -uvw[2][index1].compare(uvw[2][index2]))) {
+            counters.reductions++;
             return true;
+        }
     }
 
     return false;
@@ -524,7 +566,7 @@ bool Mod3Scheme<T>::check2Reduce() const {
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryProject(std::mt19937 &generator, int minN) {
+bool Mod3Scheme<T>::tryProject(RandomGenerator &generator, int minN) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -545,7 +587,7 @@ bool Mod3Scheme<T>::tryProject(std::mt19937 &generator, int minN) {
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank) {
+bool Mod3Scheme<T>::tryExtend(RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -560,7 +602,7 @@ bool Mod3Scheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank) {
 }
 
 template <typename T>
-bool Mod3Scheme<T>::tryMerge(const Mod3Scheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank) {
+bool Mod3Scheme<T>::tryMerge(const Mod3Scheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -617,7 +659,7 @@ void Mod3Scheme<T>::setSizes(int n1, int n2, int n3) {
 }
 
 template <typename T>
-void Mod3Scheme<T>::swapSizes(std::mt19937 &generator) {
+void Mod3Scheme<T>::swapSizes(RandomGenerator &generator) {
     int p1, p2;
 
     do {
@@ -672,6 +714,7 @@ void Mod3Scheme<T>::swapSizes(int p1, int p2) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -736,6 +779,7 @@ void Mod3Scheme<T>::merge(const Mod3Scheme<T> &scheme, int p) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -749,6 +793,7 @@ void Mod3Scheme<T>::project(int p, int q) {
 
     removeZeroes();
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -793,6 +838,7 @@ void Mod3Scheme<T>::extend(int p) {
         elements[i] = dimension[i] * dimension[(i + 1) % 3];
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -839,6 +885,7 @@ void Mod3Scheme<T>::product(const Mod3Scheme<T> &scheme2) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -851,11 +898,11 @@ void Mod3Scheme<T>::saveJson(const std::string &path) const {
     f << "    \"ring\": \"Z3\"," << std::endl;
     f << "    \"complexity\": " << getComplexity() << "," << std::endl;
 
-    saveMatrix(f, "u", uvw[0]);
+    saveMatrix(f, "u", 0);
     f << "," << std::endl;
-    saveMatrix(f, "v", uvw[1]);
+    saveMatrix(f, "v", 1);
     f << "," << std::endl;
-    saveMatrix(f, "w", uvw[2]);
+    saveMatrix(f, "w", 2);
     f << std::endl;
     f << "}" << std::endl;
 
@@ -882,47 +929,124 @@ void Mod3Scheme<T>::saveTxt(const std::string &path) const {
 template <typename T>
 void Mod3Scheme<T>::copy(const Mod3Scheme &scheme) {
     rank = scheme.rank;
+    fingerprint = scheme.fingerprint;
+    uvw.copy(scheme.uvw);
 
     for (int i = 0; i < 3; i++) {
         dimension[i] = scheme.dimension[i];
         elements[i] = scheme.elements[i];
-        uvw[i].clear();
+        flips[i] = scheme.flips[i];
+        flipsNeg[i] = scheme.flipsNeg[i];
+        buckets[i] = scheme.buckets[i];
+    }
+}
+
+template <typename T>
+void Mod3Scheme<T>::pack(std::ostream &os) const {
+    packBase(os);
+    writeBinary(os, uint32_t(sizeof(Mod3Vector<T>)));
+
+    for (int i = 0; i < 3; i++)
+        uvw.pack(os, i);
+
+    for (int i = 0; i < 3; i++)
+        flipsNeg[i].pack(os);
+}
+
+template <typename T>
+bool Mod3Scheme<T>::unpack(std::istream &is) {
+    uint32_t vectorSize;
+    if (!unpackBase(is) || !readBinary(is, vectorSize) || vectorSize != sizeof(Mod3Vector<T>) || !validateDimensions())
+        return false;
+
+    uvw.reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
+    for (int i = 0; i < 3; i++)
+        if (!uvw.unpack(is, i, rank))
+            return false;
+
+    for (int i = 0; i < 3; i++)
+        if (!flipsNeg[i].unpack(is))
+            return false;
+
+    initBuckets();
+    initFingerprint();
+    return true;
+}
 
+template <typename T>
+void Mod3Scheme<T>::packTerms(std::vector<uint8_t> &blob) const {
+    size_t position = 0;
+
+    blob.clear();
+    blob.reserve(getPackedSize());
+    writeBlob(blob, dimension);
+    writeBlob(blob, rank);
+
+    for (int i = 0; i < 3; i++) {
         for (int index = 0; index < rank; index++) {
-            Mod3Vector<T> vector(elements[i]);
+            writeBlobBits(blob, position, uvw[i][index].low, elements[i]);
+            writeBlobBits(blob, position, uvw[i][index].high, elements[i]);
+        }
+    }
+}
 
-            for (int j = 0; j < elements[i]; j++)
-                vector.set(j, scheme.uvw[i][index][j]);
+template <typename T>
+bool Mod3Scheme<T>::unpackTerms(const uint8_t *blob, size_t size) {
+    size_t position = 0;
 
-            uvw[i].emplace_back(vector);
+    if (size < sizeof(dimension) + sizeof(rank))
+        return false;
+
+    readBlob(blob, dimension);
+    readBlob(blob, rank);
+
+    for (int i = 0; i < 3; i++)
+        elements[i] = dimension[i] * dimension[(i + 1) % 3];
+
+    if (rank < 0 || !validateDimensions() || size != getPackedSize())
+        return false;
+
+    for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+        uvw[i].assign(rank, Mod3Vector<T>(elements[i]));
+
+        for (int index = 0; index < rank; index++) {
+            readBlobBits(blob, position, uvw[i][index].low, elements[i]);
+            readBlobBits(blob, position, uvw[i][index].high, elements[i]);
         }
     }
 
     initFlips();
+    initFingerprint();
+    return true;
 }
 
 template <typename T>
-bool Mod3Scheme<T>::validate() const {
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                if (!validateEquation(i, j, k))
-                    return false;
+size_t Mod3Scheme<T>::getPackedSize() const {
+    return sizeof(dimension) + sizeof(rank) + (size_t(rank) * 2 * (elements[0] + elements[1] + elements[2]) + 7) / 8;
+}
 
-    return true;
+template <typename T>
+bool Mod3Scheme<T>::validate() const {
+    return getValidator().validate();
 }
 
 template <typename T>
 bool Mod3Scheme<T>::validateParallel() const {
-    bool valid = true;
+    return getValidator().validateParallel();
+}
 
-    #pragma omp parallel for collapse(3) reduction(&&: valid) schedule(dynamic, 32)
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                valid = valid && validateEquation(i, j, k);
+template <typename T>
+BrentValidator Mod3Scheme<T>::getValidator() const {
+    BrentValidator validator(dimension[0], dimension[1], dimension[2], rank, 3);
 
-    return valid;
+    for (int i = 0; i < 3; i++)
+        for (int index = 0; index < rank; index++)
+            for (int j = 0; j < elements[i]; j++)
+                validator.set(i, index, j, uvw[i][index][j]);
+
+    return validator;
 }
 
 template <typename T>
@@ -990,23 +1114,93 @@ bool Mod3Scheme<T>::canLift(int steps) const {
 
 template <typename T>
 void Mod3Scheme<T>::initFlips() {
+    initBuckets();
+
     for (int i = 0; i < 3; i++) {
         flips[i].clear();
         flipsNeg[i].clear();
 
-        for (int index1 = 0; index1 < rank; index1++) {
-            for (int index2 = index1 + 1; index2 < rank; index2++) {
-                int cmp = uvw[i][index1].compare(uvw[i][index2]);
+        for (int index = 0; index < rank; index++) {
+            buckets[i].collect(getFlipKey(i, index), bucketIndices);
+
+            for (uint32_t other : bucketIndices) {
+                if (int(other) <= index)
+                    continue;
+
+                int cmp = uvw[i][index].compare(uvw[i][other]);
 
                 if (cmp == 1)
-                    flips[i].add(index1, index2);
+                    flips[i].add(index, other);
                 else if (cmp == -1)
-                    flipsNeg[i].add(index1, index2);
+                    flipsNeg[i].add(index, other);
             }
         }
     }
 }
 
+template <typename T>
+void Mod3Scheme<T>::initBuckets() {
+    for (int i = 0; i < 3; i++) {
+        buckets[i].reset(rank);
+
+        for (int index = 0; index < rank; index++)
+            buckets[i].add(getFlipKey(i, index), index);
+    }
+}
+
+template <typename T>
+void Mod3Scheme<T>::initFingerprint() {
+    fingerprint = getDimensionFingerprint();
+
+    for (int index = 0; index < rank; index++)
+        fingerprint += getTermFingerprint(index);
+}
+
+template <typename T>
+SchemeFingerprint Mod3Scheme<T>::getTermFingerprint(int index) const {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < 3; i++) {
+        hash = foldBits(hash, uvw[i][index].low);
+        hash = foldBits(hash, uvw[i][index].high);
+    }
+
+    return SchemeFingerprint(hash);
+}
+
+template <typename T>
+uint64_t Mod3Scheme<T>::getFlipKey(int i, int index) const {
+    return hashBits(uvw[i][index].low | uvw[i][index].high);
+}
+
+template <typename T>
+void Mod3Scheme<T>::updateFlips(int index) {
+    for (int i = 0; i < 3; i++)
+        updateFlips(i, index);
+}
+
+template <typename T>
+void Mod3Scheme<T>::updateFlips(int i, int index) {
+    uint64_t key = getFlipKey(i, index);
+
+    flips[i].remove(index);
+    flipsNeg[i].remove(index);
+    buckets[i].add(key, index);
+    buckets[i].collect(key, bucketIndices);
+
+    for (uint32_t other : bucketIndices) {
+        if (int(other) == index)
+            continue;
+
+        int cmp = uvw[i][index].compare(uvw[i][other]);
+
+        if (cmp == 1)
+            flips[i].add(index, other);
+        else if (cmp == -1)
+            flipsNeg[i].add(index, other);
+    }
+}
+
 template <typename T>
 void Mod3Scheme<T>::removeZeroes() {
     for (int index = 0; index < rank; index++)
@@ -1016,17 +1210,23 @@ void Mod3Scheme<T>::removeZeroes() {
 
 template <typename T>
 void Mod3Scheme<T>::removeAt(int index) {
+    fingerprint -= getTermFingerprint(index);
     rank--;
 
-    if (index != rank) {
-        uvw[0][index] = uvw[0].back();
-        uvw[1][index] = uvw[1].back();
-        uvw[2][index] = uvw[2].back();
-    }
+    for (int i = 0; i < 3; i++) {
+        flips[i].remove(index);
+        flipsNeg[i].remove(index);
+        buckets[i].remove(index);
+
+        if (index != rank) {
+            flips[i].move(rank, index);
+            flipsNeg[i].move(rank, index);
+            buckets[i].move(rank, index);
+            uvw[i][index] = uvw[i].back();
+        }
 
-    uvw[0].pop_back();
-    uvw[1].pop_back();
-    uvw[2].pop_back();
+        uvw[i].pop_back();
+    }
 }
 
 template <typename T>
@@ -1035,6 +1235,7 @@ void Mod3Scheme<T>::addTriplet(int i, int j, int k, const Mod3Vector<T> &u, cons
     uvw[j].emplace_back(v);
     uvw[k].emplace_back(w);
     rank++;
+    fingerprint += getTermFingerprint(rank - 1);
 }
 
 template <typename T>
@@ -1113,6 +1314,9 @@ void Mod3Scheme<T>::addRow(int matrix) {
 
 template <typename T>
 void Mod3Scheme<T>::flip(int i, int j, int k, int index1, int index2, bool pos) {
+    fingerprint -= getTermFingerprint(index1);
+    fingerprint -= getTermFingerprint(index2);
+
     if (pos)
         uvw[j][index1] += uvw[j][index2];
     else
@@ -1120,6 +1324,9 @@ void Mod3Scheme<T>::flip(int i, int j, int k, int index1, int index2, bool pos)
 
     uvw[k][index2] -= uvw[k][index1];
 
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
     flips[j].remove(index1);
     flips[k].remove(index2);
 
@@ -1127,32 +1334,57 @@ void Mod3Scheme<T>::flip(int i, int j, int k, int index1, int index2, bool pos)
     flipsNeg[k].remove(index2);
 
     if (!uvw[j][index1] || !uvw[k][index2]) {
+        updateFlips(j, index1);
+        updateFlips(k, index2);
         removeZeroes();
-        initFlips();
         return;
     }
 
-    for (int index = 0; index < rank; index++) {
-        if (index != index1) {
-            int cmp = uvw[j][index].compare(uvw[j][index1]);
-            if (cmp != 0 && checkFlipReduce(i, k, index, index1, cmp))
-                return;
-
-            if (cmp == 1)
-                flips[j].add(index1, index);
-            else if (cmp == -1)
-                flipsNeg[j].add(index1, index);
-        }
+    reduceCandidates.clear();
+
+    uint64_t key1 = getFlipKey(j, index1);
+    buckets[j].add(key1, index1);
+    buckets[j].collect(key1, bucketIndices);
+
+    for (uint32_t index : bucketIndices) {
+        int cmp = int(index) != index1 ? uvw[j][index].compare(uvw[j][index1]) : 0;
+        if (cmp != 0)
+            reduceCandidates.push_back(index * 2);
+
+        if (cmp == 1)
+            flips[j].add(index1, index);
+        else if (cmp == -1)
+            flipsNeg[j].add(index1, index);
+    }
+
+    uint64_t key2 = getFlipKey(k, index2);
+    buckets[k].add(key2, index2);
+    buckets[k].collect(key2, bucketIndices);
+
+    for (uint32_t index : bucketIndices) {
+        int cmp = int(index) != index2 ? uvw[k][index].compare(uvw[k][index2]) : 0;
+        if (cmp != 0)
+            reduceCandidates.push_back(index * 2 + 1);
+
+        if (cmp == 1)
+            flips[k].add(index2, index);
+        else if (cmp == -1)
+            flipsNeg[k].add(index2, index);
+    }
+
+    std::sort(reduceCandidates.begin(), reduceCandidates.end());
 
-        if (index != index2) {
-            int cmp = uvw[k][index].compare(uvw[k][index2]);
-            if (cmp != 0 && checkFlipReduce(i, j, index, index2, cmp))
-                return;
+    for (int candidate : reduceCandidates) {
+        int index = candidate / 2;
 
-            if (cmp == 1)
-                flips[k].add(index2, index);
-            else if (cmp == -1)
-                flipsNeg[k].add(index2, index);
+        if (candidate % 2 == 0 && checkFlipReduce(i, k, index, index1, uvw[j][index].compare(uvw[j][index1]))) {
+            counters.flipReductions++;
+            return;
+        }
+
+        if (candidate % 2 == 1 && checkFlipReduce(i, j, index, index2, uvw[k][index].compare(uvw[k][index2]))) {
+            counters.flipReductions++;
+            return;
         }
     }
 }
@@ -1175,6 +1407,9 @@ void Mod3Scheme<T>::plus(int i, int j, int k, int index1, int index2, int varian
     Mod3Vector<T> bSub = b2 - b1;
     Mod3Vector<T> cSub = c2 - c1;
 
+    fingerprint -= getTermFingerprint(index1);
+    fingerprint -= getTermFingerprint(index2);
+
     if (variant == 0) {
         uvw[j][index1] = bAdd;
         uvw[i][index2] = aSub;
@@ -1191,8 +1426,13 @@ void Mod3Scheme<T>::plus(int i, int j, int k, int index1, int index2, int varian
         addTriplet(i, j, k, a2, bSub, c1);
     }
 
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
+    updateFlips(index1);
+    updateFlips(index2);
+    updateFlips(rank - 1);
     removeZeroes();
-    initFlips();
 }
 
 template <typename T>
@@ -1202,10 +1442,13 @@ void Mod3Scheme<T>::split(int i, int j, int k, int index1, int index2) {
     Mod3Vector<T> w(uvw[k][index1]);
 
     addTriplet(i, j, k, u, v, w);
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] = uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
 
+    updateFlips(index1);
+    updateFlips(rank - 1);
     removeZeroes();
-    initFlips();
 }
 
 template <typename T>
@@ -1223,28 +1466,30 @@ bool Mod3Scheme<T>::reduce(int i, int index1, int index2, int sign) {
 
 template <typename T>
 void Mod3Scheme<T>::reduceAdd(int i, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] += uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
     bool isZero = !uvw[i][index1];
 
+    updateFlips(i, index1);
     removeAt(index2);
 
     if (isZero)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
 void Mod3Scheme<T>::reduceSub(int i, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] -= uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
     bool isZero = !uvw[i][index1];
 
+    updateFlips(i, index1);
     removeAt(index2);
 
     if (isZero)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
@@ -1342,24 +1587,6 @@ bool Mod3Scheme<T>::validateDimensions() const {
     return true;
 }
 
-template <typename T>
-bool Mod3Scheme<T>::validateEquation(int i, int j, int k) const {
-    int i1 = i / dimension[1];
-    int i2 = i % dimension[1];
-    int j1 = j / dimension[2];
-    int j2 = j % dimension[2];
-    int k1 = k / dimension[0];
-    int k2 = k % dimension[0];
-
-    int target = (i2 == j1) && (i1 == k2) && (j2 == k1);
-    int equation = 0;
-
-    for (int index = 0; index < rank; index++)
-        equation += uvw[0][index][i] * uvw[1][index][j] * uvw[2][index][k];
-
-    return equation % 3 == target;
-}
-
 template <typename T>
 void Mod3Scheme<T>::normalize() {
     for (int index = 0; index < rank; index++) {
@@ -1384,14 +1611,15 @@ void Mod3Scheme<T>::normalize() {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
-void Mod3Scheme<T>::saveMatrix(std::ofstream &f, std::string name, const std::vector<Mod3Vector<T>> &vectors) const {
+void Mod3Scheme<T>::saveMatrix(std::ofstream &f, std::string name, int matrix) const {
     f << "    \"" << name << "\": [" << std::endl;
 
-    for (size_t index = 0; index < vectors.size(); index++)
-        f << "        [" << vectors[index] << "]" << (index < vectors.size() - 1 ? "," : "") << std::endl;
+    for (int index = 0; index < rank; index++)
+        f << "        [" << uvw[matrix][index] << "]" << (index < rank - 1 ? "," : "") << std::endl;
 
     f << "    ]";
 }
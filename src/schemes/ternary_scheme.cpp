@@ -1,8 +1,10 @@
 #include "ternary_scheme.hpp"
-#include "../entities/uint256_t.h"
+#include "../entities/bit_vector.hpp"
 
 template class TernaryScheme<uint16_t>;
 template class TernaryScheme<uint32_t>;
 template class TernaryScheme<uint64_t>;
 template class TernaryScheme<__uint128_t>;
 template class TernaryScheme<uint256_t>;
+template class TernaryScheme<uint512_t>;
+template class TernaryScheme<uint1024_t>;
@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "../entities/ternary_vector.hpp"
+#include "../entities/scheme_arena.hpp"
 #include "../entities/ranks.h"
 #include "../entities/invariants_builder.h"
 #include "../algebra/matrix.h"
@@ -19,8 +20,11 @@
 template <typename T>
 class TernaryScheme : public BaseScheme {
 protected:
-    std::vector<TernaryVector<T>> uvw[3];
-    std::vector<int> indices;
+    SchemeArena<TernaryVector<T>> uvw;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> indicesStamps;
+    uint32_t indicesStamp;
+    std::vector<int> reduceCandidates;
 public:
     TernaryScheme();
     TernaryScheme(const TernaryScheme<T> &scheme);
@@ -41,17 +45,17 @@ public:
     std::vector<std::vector<int>> getExpressionsV() const;
     std::vector<std::vector<int>> getExpressionsW() const;
 
-    bool tryFlip(std::mt19937 &generator);
-    bool tryPlus(std::mt19937 &generator);
-    bool trySplit(std::mt19937 &generator);
-    bool tryExpand(std::mt19937 &generator);
-    bool trySandwiching(std::mt19937 &generator);
+    bool tryFlip(RandomGenerator &generator);
+    bool tryPlus(RandomGenerator &generator);
+    bool trySplit(RandomGenerator &generator);
+    bool tryExpand(RandomGenerator &generator);
+    bool trySandwiching(RandomGenerator &generator);
     bool tryReduce();
     bool check2Reduce() const;
 
-    bool tryProject(std::mt19937 &generator, int minN);
-    bool tryExtend(std::mt19937 &generator, int maxN, int maxRank);
-    bool tryMerge(const TernaryScheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank);
+    bool tryProject(RandomGenerator &generator, int minN);
+    bool tryExtend(RandomGenerator &generator, int maxN, int maxRank);
+    bool tryMerge(const TernaryScheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank);
     bool tryProduct(const TernaryScheme<T> &scheme, int maxN, int maxRank);
 
     bool isValidProject(int p, int minN) const;
@@ -61,7 +65,7 @@ public:
 
     void fixSizes();
     void setSizes(int n1, int n2, int n3);
-    void swapSizes(std::mt19937 &generator);
+    void swapSizes(RandomGenerator &generator);
     void swapSizes(int p1, int p2);
     void merge(const TernaryScheme<T> &scheme, int p);
     void project(int p, int q);
@@ -71,6 +75,10 @@ public:
     void saveJson(const std::string &path) const;
     void saveTxt(const std::string &path) const;
     void copy(const TernaryScheme<T> &scheme);
+    void pack(std::ostream &os) const;
+    bool unpack(std::istream &is);
+    void packTerms(std::vector<uint8_t> &blob) const;
+    bool unpackTerms(const uint8_t *blob, size_t size);
 
     bool validate() const;
     bool validateParallel() const;
@@ -79,6 +87,12 @@ public:
     bool canLift(int steps) const;
 protected:
     void initFlips();
+    void initBuckets();
+    void initFingerprint();
+    SchemeFingerprint getTermFingerprint(int index) const;
+    uint64_t getFlipKey(int i, int index) const;
+    void updateFlips(int index);
+    void updateFlips(int i, int index);
     void removeZeroes();
     void removeAt(int index);
     void addTriplet(int i, int j, int k, const TernaryVector<T> &u, const TernaryVector<T> &v, const TernaryVector<T> &w);
@@ -96,18 +110,21 @@ protected:
 
 
     bool fixSigns();
+    bool fixSigns(int index);
     bool validateDimensions() const;
-    bool validateEquation(int i, int j, int k) const;
-    void saveMatrix(std::ofstream &f, std::string name, const std::vector<TernaryVector<T>> &vectors) const;
+    size_t getPackedSize() const;
+    BrentValidator getValidator() const;
+    void saveMatrix(std::ofstream &f, std::string name, int matrix) const;
 };
 
 template <typename T>
 TernaryScheme<T>::TernaryScheme() {
-
+    indicesStamp = 0;
 }
 
 template <typename T>
 TernaryScheme<T>::TernaryScheme(const TernaryScheme<T> &scheme) {
+    indicesStamp = 0;
     copy(scheme);
 }
 
@@ -126,9 +143,10 @@ bool TernaryScheme<T>::initializeNaive(int n1, int n2, int n3) {
     if (!validateDimensions())
         return false;
 
-    uvw[0].clear();
-    uvw[1].clear();
-    uvw[2].clear();
+    for (int i = 0; i < 3; i++) {
+        uvw[i].clear();
+        uvw[i].reserve(rank);
+    }
 
     for (int i = 0; i < n1; i++) {
         for (int j = 0; j < n3; j++) {
@@ -141,6 +159,7 @@ bool TernaryScheme<T>::initializeNaive(int n1, int n2, int n3) {
     }
 
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -175,6 +194,8 @@ bool TernaryScheme<T>::read(std::istream &is, bool checkCorrectness) {
         return false;
 
     for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
         for (int index = 0; index < rank; index++) {
             TernaryVector<T> vector(elements[i]);
             is >> vector;
@@ -187,6 +208,7 @@ bool TernaryScheme<T>::read(std::istream &is, bool checkCorrectness) {
 
     fixSigns();
     initFlips();
+    initFingerprint();
     return true;
 }
 
@@ -307,20 +329,30 @@ std::vector<std::vector<int>> TernaryScheme<T>::getExpressionsW() const {
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryFlip(std::mt19937 &generator) {
+bool TernaryScheme<T>::tryFlip(RandomGenerator &generator) {
     size_t size = flips[0].size() + flips[1].size() + flips[2].size();
 
-    if (!size)
+    if (!size) {
+        counters.failedFlips++;
         return false;
+    }
 
-    indices.resize(size);
-    for (size_t i = 0; i < size; i++)
-        indices[i] = i;
+    if (indices.size() < size) {
+        indices.resize(size);
+        indicesStamps.resize(size, indicesStamp);
+    }
+
+    if (++indicesStamp == 0) {
+        std::fill(indicesStamps.begin(), indicesStamps.end(), 0);
+        indicesStamp = 1;
+    }
 
     for (size_t p = 0; p < size; p++) {
-        size_t q = generator() % (size - p);
-        size_t index = indices[q];
-        std::swap(indices[p], indices[q]);
+        size_t q = p + generator() % (size - p);
+        size_t index = indicesStamps[q] == indicesStamp ? indices[q] : q;
+        indices[q] = indicesStamps[p] == indicesStamp ? indices[p] : p;
+        indicesStamps[q] = indicesStamp;
+        counters.flipCandidates++;
 
         int i, j, k;
 
@@ -356,6 +388,7 @@ bool TernaryScheme<T>::tryFlip(std::mt19937 &generator) {
                 flip(i, j, k, index1, index2);
             else
                 flip(i, j, k, index2, index1);
+            counters.flips++;
             return true;
         }
 
@@ -364,15 +397,19 @@ bool TernaryScheme<T>::tryFlip(std::mt19937 &generator) {
                 flip(i, k, j, index1, index2);
             else
                 flip(i, k, j, index2, index1);
+            counters.flips++;
             return true;
         }
+
+        counters.rejectedFlips++;
     }
 
+    counters.failedFlips++;
     return false;
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryPlus(std::mt19937 &generator) {
+bool TernaryScheme<T>::tryPlus(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1 = distribution(generator);
     int index2 = distribution(generator);
@@ -385,11 +422,17 @@ bool TernaryScheme<T>::tryPlus(std::mt19937 &generator) {
     int permutation[3] = {0, 1, 2};
     std::shuffle(permutation, permutation + 3, generator);
 
-    return plus(permutation[0], permutation[1], permutation[2], index1, index2, ijkDistribution(generator));
+    if (!plus(permutation[0], permutation[1], permutation[2], index1, index2, ijkDistribution(generator))) {
+        counters.failedPlus++;
+        return false;
+    }
+
+    counters.plus++;
+    return true;
 }
 
 template <typename T>
-bool TernaryScheme<T>::trySplit(std::mt19937 &generator) {
+bool TernaryScheme<T>::trySplit(RandomGenerator &generator) {
     std::uniform_int_distribution<int> distribution(0, rank - 1);
     int index1, index2, i;
 
@@ -399,21 +442,26 @@ bool TernaryScheme<T>::trySplit(std::mt19937 &generator) {
         i = ijkDistribution(generator);
     } while (index1 == index2 || uvw[i][index1] == uvw[i][index2]);
 
-    if (!uvw[i][index1].limitSub(uvw[i][index2], false))
+    if (!uvw[i][index1].limitSub(uvw[i][index2], false)) {
+        counters.failedSplits++;
         return false;
+    }
 
     if (i == 2 || uvw[i][index1].positiveFirstNonZeroSub(uvw[i][index2]))
         split(i, (i + 1) % 3, (i + 2) % 3, index1, index2);
     else
         split(i, (i + 1) % 3, (i + 2) % 3, index2, index1);
 
+    counters.splits++;
     return true;
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryExpand(std::mt19937 &generator) {
-    if (rank >= dimension[0] * dimension[1] * dimension[2])
+bool TernaryScheme<T>::tryExpand(RandomGenerator &generator) {
+    if (rank >= dimension[0] * dimension[1] * dimension[2]) {
+        counters.failedExpands++;
         return false;
+    }
 
     if (boolDistribution(generator))
         return tryPlus(generator);
@@ -422,7 +470,7 @@ bool TernaryScheme<T>::tryExpand(std::mt19937 &generator) {
 }
 
 template <typename T>
-bool TernaryScheme<T>::trySandwiching(std::mt19937 &generator) {
+bool TernaryScheme<T>::trySandwiching(RandomGenerator &generator) {
     Matrix u(dimension[0], dimension[0]);
     Matrix v(dimension[1], dimension[1]);
     Matrix w(dimension[2], dimension[2]);
@@ -443,8 +491,10 @@ bool TernaryScheme<T>::trySandwiching(std::mt19937 &generator) {
         w.random(-1, 1, 1, generator);
     } while (!w.invertible(w1));
 
-    if (!u1.isTernary() || !v1.isTernary() || !w1.isTernary())
+    if (!u1.isTernary() || !v1.isTernary() || !w1.isTernary()) {
+        counters.rejectedSandwichings++;
         return false;
+    }
 
     std::vector<Matrix> mus, mvs, mws;
     mus.reserve(rank);
@@ -469,8 +519,10 @@ bool TernaryScheme<T>::trySandwiching(std::mt19937 &generator) {
         mv.sandwich(v, w1);
         mw.sandwich(w, u1);
 
-        if (!mu.isTernary() || !mv.isTernary() || !mw.isTernary())
+        if (!mu.isTernary() || !mv.isTernary() || !mw.isTernary()) {
+            counters.rejectedSandwichings++;
             return false;
+        }
 
         mus.emplace_back(mu);
         mvs.emplace_back(mv);
@@ -490,6 +542,8 @@ bool TernaryScheme<T>::trySandwiching(std::mt19937 &generator) {
 
     fixSigns();
     initFlips();
+    initFingerprint();
+    counters.sandwichings++;
     return true;
 }
 
@@ -501,17 +555,20 @@ bool TernaryScheme<T>::tryReduce() {
 
         if (uvw[1][index1] == uvw[1][index2] && uvw[2][index1].limitSum(uvw[2][index2], false)) {
             reduceAdd(2, index1, index2);
+            counters.reductions++;
             return true;
         }
 
         int cmp2 = uvw[2][index1].compare(uvw[2][index2]);
         if (cmp2 == 1 && uvw[1][index1].limitSum(uvw[1][index2], true)) {
             reduceAdd(1, index1, index2);
+            counters.reductions++;
             return true;
         }
 
         if (cmp2 == -1 && uvw[1][index1].limitSub(uvw[1][index2], true)) {
             reduceSub(1, index1, index2);
+            counters.reductions++;
             return true;
         }
     }
@@ -523,11 +580,13 @@ bool TernaryScheme<T>::tryReduce() {
 
         if (cmp2 == 1 && uvw[0][index1].limitSum(uvw[0][index2], true)) {
             reduceAdd(0, index1, index2);
+            counters.reductions++;
             return true;
         }
 
         if (cmp2 == -1 && uvw[0][index1].limitSub(uvw[0][index2], true)) {
             reduceSub(0, index1, index2);
+            counters.reductions++;
             return true;
         }
     }
@@ -558,7 +617,7 @@ bool TernaryScheme<T>::check2Reduce() const {
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryProject(std::mt19937 &generator, int minN) {
+bool TernaryScheme<T>::tryProject(RandomGenerator &generator, int minN) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -579,7 +638,7 @@ bool TernaryScheme<T>::tryProject(std::mt19937 &generator, int minN) {
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank) {
+bool TernaryScheme<T>::tryExtend(RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -594,7 +653,7 @@ bool TernaryScheme<T>::tryExtend(std::mt19937 &generator, int maxN, int maxRank)
 }
 
 template <typename T>
-bool TernaryScheme<T>::tryMerge(const TernaryScheme<T> &scheme, std::mt19937 &generator, int maxN, int maxRank) {
+bool TernaryScheme<T>::tryMerge(const TernaryScheme<T> &scheme, RandomGenerator &generator, int maxN, int maxRank) {
     std::vector<int> indices;
 
     for (int i = 0; i < 3; i++)
@@ -651,7 +710,7 @@ void TernaryScheme<T>::setSizes(int n1, int n2, int n3) {
 }
 
 template <typename T>
-void TernaryScheme<T>::swapSizes(std::mt19937 &generator) {
+void TernaryScheme<T>::swapSizes(RandomGenerator &generator) {
     int p1, p2;
 
     do {
@@ -707,6 +766,7 @@ void TernaryScheme<T>::swapSizes(int p1, int p2) {
 
     fixSigns();
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -771,6 +831,7 @@ void TernaryScheme<T>::merge(const TernaryScheme<T> &scheme, int p) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -785,6 +846,7 @@ void TernaryScheme<T>::project(int p, int q) {
     removeZeroes();
     fixSigns();
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -829,6 +891,7 @@ void TernaryScheme<T>::extend(int p) {
         elements[i] = dimension[i] * dimension[(i + 1) % 3];
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -875,6 +938,7 @@ void TernaryScheme<T>::product(const TernaryScheme<T> &scheme2) {
     }
 
     initFlips();
+    initFingerprint();
 }
 
 template <typename T>
@@ -887,11 +951,11 @@ void TernaryScheme<T>::saveJson(const std::string &path) const {
     f << "    \"z2\": false," << std::endl;
     f << "    \"complexity\": " << getComplexity() << "," << std::endl;
 
-    saveMatrix(f, "u", uvw[0]);
+    saveMatrix(f, "u", 0);
     f << "," << std::endl;
-    saveMatrix(f, "v", uvw[1]);
+    saveMatrix(f, "v", 1);
     f << "," << std::endl;
-    saveMatrix(f, "w", uvw[2]);
+    saveMatrix(f, "w", 2);
     f << std::endl;
     f << "}" << std::endl;
 
@@ -918,32 +982,100 @@ void TernaryScheme<T>::saveTxt(const std::string &path) const {
 template <typename T>
 void TernaryScheme<T>::copy(const TernaryScheme<T> &scheme) {
     rank = scheme.rank;
+    fingerprint = scheme.fingerprint;
+    uvw.copy(scheme.uvw);
 
     for (int i = 0; i < 3; i++) {
         dimension[i] = scheme.dimension[i];
         elements[i] = scheme.elements[i];
-        uvw[i].clear();
+        flips[i] = scheme.flips[i];
+        buckets[i] = scheme.buckets[i];
+    }
+}
+
+template <typename T>
+void TernaryScheme<T>::pack(std::ostream &os) const {
+    packBase(os);
+    writeBinary(os, uint32_t(sizeof(TernaryVector<T>)));
+
+    for (int i = 0; i < 3; i++)
+        uvw.pack(os, i);
+}
+
+template <typename T>
+bool TernaryScheme<T>::unpack(std::istream &is) {
+    uint32_t vectorSize;
+    if (!unpackBase(is) || !readBinary(is, vectorSize) || vectorSize != sizeof(TernaryVector<T>) || !validateDimensions())
+        return false;
+
+    uvw.reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+
+    for (int i = 0; i < 3; i++)
+        if (!uvw.unpack(is, i, rank))
+            return false;
+
+    initBuckets();
+    initFingerprint();
+    return true;
+}
+
+template <typename T>
+void TernaryScheme<T>::packTerms(std::vector<uint8_t> &blob) const {
+    size_t position = 0;
+
+    blob.clear();
+    blob.reserve(getPackedSize());
+    writeBlob(blob, dimension);
+    writeBlob(blob, rank);
 
+    for (int i = 0; i < 3; i++) {
         for (int index = 0; index < rank; index++) {
-            TernaryVector<T> vector(elements[i]);
+            writeBlobBits(blob, position, uvw[i][index].values, elements[i]);
+            writeBlobBits(blob, position, uvw[i][index].signs, elements[i]);
+        }
+    }
+}
 
-            for (int j = 0; j < elements[i]; j++)
-                vector.set(j, scheme.uvw[i][index][j]);
+template <typename T>
+bool TernaryScheme<T>::unpackTerms(const uint8_t *blob, size_t size) {
+    size_t position = 0;
 
-            uvw[i].emplace_back(vector);
+    if (size < sizeof(dimension) + sizeof(rank))
+        return false;
+
+    readBlob(blob, dimension);
+    readBlob(blob, rank);
+
+    for (int i = 0; i < 3; i++)
+        elements[i] = dimension[i] * dimension[(i + 1) % 3];
+
+    if (rank < 0 || !validateDimensions() || size != getPackedSize())
+        return false;
+
+    for (int i = 0; i < 3; i++) {
+        uvw[i].reserve(std::max(rank, dimension[0] * dimension[1] * dimension[2]));
+        uvw[i].assign(rank, TernaryVector<T>(elements[i]));
+
+        for (int index = 0; index < rank; index++) {
+            readBlobBits(blob, position, uvw[i][index].values, elements[i]);
+            readBlobBits(blob, position, uvw[i][index].signs, elements[i]);
         }
     }
 
     initFlips();
+    initFingerprint();
+    return true;
+}
+
+template <typename T>
+size_t TernaryScheme<T>::getPackedSize() const {
+    return sizeof(dimension) + sizeof(rank) + (size_t(rank) * 2 * (elements[0] + elements[1] + elements[2]) + 7) / 8;
 }
 
 template <typename T>
 bool TernaryScheme<T>::validate() const {
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                if (!validateEquation(i, j, k))
-                    return false;
+    if (!getValidator().validate())
+        return false;
 
     for (int i = 0; i < 3; i++)
         for (int index = 0; index < rank; index++)
@@ -955,15 +1087,19 @@ bool TernaryScheme<T>::validate() const {
 
 template <typename T>
 bool TernaryScheme<T>::validateParallel() const {
-    bool valid = true;
+    return getValidator().validateParallel();
+}
 
-    #pragma omp parallel for collapse(3) reduction(&&: valid) schedule(dynamic, 32)
-    for (int i = 0; i < elements[0]; i++)
-        for (int j = 0; j < elements[1]; j++)
-            for (int k = 0; k < elements[2]; k++)
-                valid = valid && validateEquation(i, j, k);
+template <typename T>
+BrentValidator TernaryScheme<T>::getValidator() const {
+    BrentValidator validator(dimension[0], dimension[1], dimension[2], rank, 0);
+
+    for (int i = 0; i < 3; i++)
+        for (int index = 0; index < rank; index++)
+            for (int j = 0; j < elements[i]; j++)
+                validator.set(i, index, j, uvw[i][index][j]);
 
-    return valid;
+    return validator;
 }
 
 template <typename T>
@@ -994,14 +1130,75 @@ bool TernaryScheme<T>::canLift(int steps) const {
 
 template <typename T>
 void TernaryScheme<T>::initFlips() {
+    initBuckets();
+
     for (int i = 0; i < 3; i++) {
         flips[i].clear();
 
-        for (int index1 = 0; index1 < rank; index1++)
-            for (int index2 = index1 + 1; index2 < rank; index2++)
-                if (uvw[i][index1] == uvw[i][index2])
-                    flips[i].add(index1, index2);
+        for (int index = 0; index < rank; index++) {
+            buckets[i].collect(getFlipKey(i, index), bucketIndices);
+
+            for (uint32_t other : bucketIndices)
+                if (int(other) > index && uvw[i][other] == uvw[i][index])
+                    flips[i].add(index, other);
+        }
+    }
+}
+
+template <typename T>
+void TernaryScheme<T>::initBuckets() {
+    for (int i = 0; i < 3; i++) {
+        buckets[i].reset(rank);
+
+        for (int index = 0; index < rank; index++)
+            buckets[i].add(getFlipKey(i, index), index);
+    }
+}
+
+template <typename T>
+void TernaryScheme<T>::initFingerprint() {
+    fingerprint = getDimensionFingerprint();
+
+    for (int index = 0; index < rank; index++)
+        fingerprint += getTermFingerprint(index);
+}
+
+template <typename T>
+SchemeFingerprint TernaryScheme<T>::getTermFingerprint(int index) const {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < 3; i++) {
+        hash = foldBits(hash, uvw[i][index].values);
+        hash = foldBits(hash, uvw[i][index].signs);
     }
+
+    return SchemeFingerprint(hash);
+}
+
+template <typename T>
+uint64_t TernaryScheme<T>::getFlipKey(int i, int index) const {
+    return hashBits(uvw[i][index].values);
+}
+
+template <typename T>
+void TernaryScheme<T>::updateFlips(int index) {
+    fixSigns(index);
+
+    for (int i = 0; i < 3; i++)
+        updateFlips(i, index);
+}
+
+template <typename T>
+void TernaryScheme<T>::updateFlips(int i, int index) {
+    uint64_t key = getFlipKey(i, index);
+
+    flips[i].remove(index);
+    buckets[i].add(key, index);
+    buckets[i].collect(key, bucketIndices);
+
+    for (uint32_t other : bucketIndices)
+        if (int(other) != index && uvw[i][other] == uvw[i][index])
+            flips[i].add(index, other);
 }
 
 template <typename T>
@@ -1013,17 +1210,21 @@ void TernaryScheme<T>::removeZeroes() {
 
 template <typename T>
 void TernaryScheme<T>::removeAt(int index) {
+    fingerprint -= getTermFingerprint(index);
     rank--;
 
-    if (index != rank) {
-        uvw[0][index] = uvw[0].back();
-        uvw[1][index] = uvw[1].back();
-        uvw[2][index] = uvw[2].back();
-    }
+    for (int i = 0; i < 3; i++) {
+        flips[i].remove(index);
+        buckets[i].remove(index);
+
+        if (index != rank) {
+            flips[i].move(rank, index);
+            buckets[i].move(rank, index);
+            uvw[i][index] = uvw[i].back();
+        }
 
-    uvw[0].pop_back();
-    uvw[1].pop_back();
-    uvw[2].pop_back();
+        uvw[i].pop_back();
+    }
 }
 
 template <typename T>
@@ -1032,6 +1233,7 @@ void TernaryScheme<T>::addTriplet(int i, int j, int k, const TernaryVector<T> &u
     uvw[j].emplace_back(v);
     uvw[k].emplace_back(w);
     rank++;
+    fingerprint += getTermFingerprint(rank - 1);
 }
 
 template <typename T>
@@ -1110,38 +1312,69 @@ void TernaryScheme<T>::addRow(int matrix) {
 
 template <typename T>
 void TernaryScheme<T>::flip(int i, int j, int k, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
+    fingerprint -= getTermFingerprint(index2);
+
     uvw[j][index1] += uvw[j][index2];
     uvw[k][index2] -= uvw[k][index1];
 
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
     flips[j].remove(index1);
     flips[k].remove(index2);
 
     if (!uvw[j][index1] || !uvw[k][index2]) {
+        updateFlips(j, index1);
+        updateFlips(k, index2);
         removeZeroes();
-        initFlips();
 
         while (tryReduce())
             ;
         return;
     }
 
-    for (int index = 0; index < rank; index++) {
-        if (index != index1) {
-            int cmp = uvw[j][index].compare(uvw[j][index1]);
-            if (cmp != 0 && checkFlipReduce(i, k, index, index1, cmp))
-                return;
+    reduceCandidates.clear();
 
-            if (cmp == 1)
-                flips[j].add(index1, index);
-        }
+    uint64_t key1 = getFlipKey(j, index1);
+    buckets[j].add(key1, index1);
+    buckets[j].collect(key1, bucketIndices);
+
+    for (uint32_t index : bucketIndices) {
+        int cmp = int(index) != index1 ? uvw[j][index].compare(uvw[j][index1]) : 0;
+        if (cmp != 0)
+            reduceCandidates.push_back(index * 2);
+
+        if (cmp == 1)
+            flips[j].add(index1, index);
+    }
+
+    uint64_t key2 = getFlipKey(k, index2);
+    buckets[k].add(key2, index2);
+    buckets[k].collect(key2, bucketIndices);
+
+    for (uint32_t index : bucketIndices) {
+        int cmp = int(index) != index2 ? uvw[k][index].compare(uvw[k][index2]) : 0;
+        if (cmp != 0)
+            reduceCandidates.push_back(index * 2 + 1);
 
-        if (index != index2) {
-            int cmp = uvw[k][index].compare(uvw[k][index2]);
-            if (cmp != 0 && checkFlipReduce(i, j, index, index2, cmp))
-                return;
+        if (cmp == 1)
+            flips[k].add(index2, index);
+    }
+
+    std::sort(reduceCandidates.begin(), reduceCandidates.end());
+
+    for (int candidate : reduceCandidates) {
+        int index = candidate / 2;
+
+        if (candidate % 2 == 0 && checkFlipReduce(i, k, index, index1, uvw[j][index].compare(uvw[j][index1]))) {
+            counters.flipReductions++;
+            return;
+        }
 
-            if (cmp == 1)
-                flips[k].add(index2, index);
+        if (candidate % 2 == 1 && checkFlipReduce(i, j, index, index2, uvw[k][index].compare(uvw[k][index2]))) {
+            counters.flipReductions++;
+            return;
         }
     }
 }
@@ -1164,6 +1397,9 @@ bool TernaryScheme<T>::plus(int i, int j, int k, int index1, int index2, int var
     TernaryVector<T> bSub = b2 - b1;
     TernaryVector<T> cSub = c2 - c1;
 
+    SchemeFingerprint removed = getTermFingerprint(index1);
+    removed += getTermFingerprint(index2);
+
     if (variant == 0 && aSub.limit(i != 2) && bAdd.limit(j != 2) && cSub.limit(k != 2)) {
         uvw[j][index1] = bAdd;
         uvw[i][index2] = aSub;
@@ -1182,9 +1418,14 @@ bool TernaryScheme<T>::plus(int i, int j, int k, int index1, int index2, int var
     else
         return false;
 
+    fingerprint -= removed;
+    fingerprint += getTermFingerprint(index1);
+    fingerprint += getTermFingerprint(index2);
+
+    updateFlips(index1);
+    updateFlips(index2);
+    updateFlips(rank - 1);
     removeZeroes();
-    fixSigns();
-    initFlips();
     return true;
 }
 
@@ -1195,37 +1436,41 @@ void TernaryScheme<T>::split(int i, int j, int k, int index1, int index2) {
     TernaryVector<T> w(uvw[k][index1]);
 
     addTriplet(i, j, k, u, v, w);
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] = uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
 
+    updateFlips(index1);
+    updateFlips(rank - 1);
     removeZeroes();
-    fixSigns();
-    initFlips();
 }
 
 template <typename T>
 void TernaryScheme<T>::reduceAdd(int i, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] += uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
     bool isZero = !uvw[i][index1];
 
+    updateFlips(i, index1);
     removeAt(index2);
 
     if (isZero)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
 void TernaryScheme<T>::reduceSub(int i, int index1, int index2) {
+    fingerprint -= getTermFingerprint(index1);
     uvw[i][index1] -= uvw[i][index2];
+    fingerprint += getTermFingerprint(index1);
     bool isZero = !uvw[i][index1];
 
+    updateFlips(i, index1);
     removeAt(index2);
 
     if (isZero)
         removeZeroes();
-
-    initFlips();
 }
 
 template <typename T>
@@ -1323,30 +1568,38 @@ template <typename T>
 bool TernaryScheme<T>::fixSigns() {
     bool changed = false;
 
-    for (int index = 0; index < rank; index++) {
-        bool i = uvw[0][index].positiveFirstNonZero();
-        bool j = uvw[1][index].positiveFirstNonZero();
+    for (int index = 0; index < rank; index++)
+        if (fixSigns(index))
+            changed = true;
 
-        if (i && j)
-            continue;
+    return changed;
+}
 
-        if (!i && !j) {
-            uvw[0][index].inverse();
-            uvw[1][index].inverse();
-        }
-        else if (!i) {
-            uvw[0][index].inverse();
-            uvw[2][index].inverse();
-        }
-        else {
-            uvw[1][index].inverse();
-            uvw[2][index].inverse();
-        }
+template <typename T>
+bool TernaryScheme<T>::fixSigns(int index) {
+    bool i = uvw[0][index].positiveFirstNonZero();
+    bool j = uvw[1][index].positiveFirstNonZero();
+
+    if (i && j)
+        return false;
+
+    fingerprint -= getTermFingerprint(index);
 
-        changed = true;
+    if (!i && !j) {
+        uvw[0][index].inverse();
+        uvw[1][index].inverse();
+    }
+    else if (!i) {
+        uvw[0][index].inverse();
+        uvw[2][index].inverse();
+    }
+    else {
+        uvw[1][index].inverse();
+        uvw[2][index].inverse();
     }
 
-    return changed;
+    fingerprint += getTermFingerprint(index);
+    return true;
 }
 
 template <typename T>
@@ -1374,29 +1627,11 @@ bool TernaryScheme<T>::validateDimensions() const {
 }
 
 template <typename T>
-bool TernaryScheme<T>::validateEquation(int i, int j, int k) const {
-    int i1 = i / dimension[1];
-    int i2 = i % dimension[1];
-    int j1 = j / dimension[2];
-    int j2 = j % dimension[2];
-    int k1 = k / dimension[0];
-    int k2 = k % dimension[0];
-
-    int target = (i2 == j1) && (i1 == k2) && (j2 == k1);
-    int equation = 0;
-
-    for (int index = 0; index < rank; index++)
-        equation += uvw[0][index][i] * uvw[1][index][j] * uvw[2][index][k];
-
-    return equation == target;
-}
-
-template <typename T>
-void TernaryScheme<T>::saveMatrix(std::ofstream &f, std::string name, const std::vector<TernaryVector<T>> &vectors) const {
+void TernaryScheme<T>::saveMatrix(std::ofstream &f, std::string name, int matrix) const {
     f << "    \"" << name << "\": [" << std::endl;
 
-    for (size_t index = 0; index < vectors.size(); index++)
-        f << "        [" << vectors[index] << "]" << (index < vectors.size() - 1 ? "," : "") << std::endl;
+    for (int index = 0; index < rank; index++)
+        f << "        [" << uvw[matrix][index] << "]" << (index < rank - 1 ? "," : "") << std::endl;
 
     f << "    ]";
 }
@@ -15,6 +15,21 @@ std::string prettyInt(size_t value) {
     return ss.str();
 }
 
+std::string prettyBytes(size_t bytes) {
+    std::stringstream ss;
+
+    if (bytes < 1024)
+        ss << bytes << " B";
+    else if (bytes < 1024 * 1024)
+        ss << std::setprecision(2) << std::fixed << (bytes / 1024.0) << " KB";
+    else if (bytes < 1024 * 1024 * 1024)
+        ss << std::setprecision(1) << std::fixed << (bytes / (1024.0 * 1024.0)) << " MB";
+    else
+        ss << std::setprecision(2) << std::fixed << (bytes / (1024.0 * 1024.0 * 1024.0)) << " GB";
+
+    return ss.str();
+}
+
 std::string prettyTime(double elapsed) {
     std::stringstream ss;
 
@@ -150,17 +165,17 @@ int getMaxMatrixElements(const std::string &path, bool multiple) {
 
     int maxMatrixElements = std::max(n1 * n2, std::max(n2 * n3, n3 * n1));
 
-    if (maxMatrixElements > 256) {
-        std::cerr << "Max matrix elements too big (> 256): " << n1 << "x" << n2 << "x" << n3 << std::endl;
+    if (maxMatrixElements > 1024) {
+        std::cerr << "Max matrix elements too big (> 1024): " << n1 << "x" << n2 << "x" << n3 << std::endl;
         return -1;
     }
 
     return maxMatrixElements;
 }
 
-std::vector<std::mt19937> initRandomGenerators(int seed, int count) {
+std::vector<RandomGenerator> initRandomGenerators(int seed, int count, const std::string &type) {
     std::mt19937 generator(seed);
-    std::vector<std::mt19937> generators;
+    std::vector<RandomGenerator> generators;
     generators.reserve(count);
 
     for (int i = 0; i < count; i++) {
@@ -169,7 +184,7 @@ std::vector<std::mt19937> initRandomGenerators(int seed, int count) {
             value = generator();
 
         std::seed_seq seq(std::begin(seedData), std::end(seedData));
-        generators.emplace_back(seq);
+        generators.emplace_back(seq, type);
     }
 
     return generators;
@@ -5,14 +5,17 @@
 #include <iomanip>
 #include <random>
 #include <vector>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <chrono>
 #include <algorithm>
 #include <filesystem>
 #include "algebra/fraction.h"
+#include "entities/random_generator.h"
 
 std::string prettyInt(size_t value);
+std::string prettyBytes(size_t bytes);
 std::string prettyTime(double elapsed);
 std::string prettyTime(const std::chrono::high_resolution_clock::time_point& t1, const std::chrono::high_resolution_clock::time_point& t2);
 
@@ -25,7 +28,20 @@ bool endsWith(const std::string &s, const std::string &substr);
 bool endsWith(const std::string &s, const std::vector<std::string> &substrs);
 std::string join(const std::vector<std::string> &values, const std::string& delimeter = "");
 int getMaxMatrixElements(const std::string &path, bool multiple);
-std::vector<std::mt19937> initRandomGenerators(int seed, int count);
+std::vector<RandomGenerator> initRandomGenerators(int seed, int count, const std::string &type);
+
+// runners are created inside a parallel loop, so the memory of each runner is first touched by a worker thread, not by the main one
+template <typename Runner>
+std::vector<std::unique_ptr<Runner>> initRunners(int seed, int count, const std::string &type, int threads) {
+    std::vector<RandomGenerator> generators = initRandomGenerators(seed, count, type);
+    std::vector<std::unique_ptr<Runner>> runners(count);
+
+    #pragma omp parallel for num_threads(threads)
+    for (int i = 0; i < count; i++)
+        runners[i] = std::make_unique<Runner>(generators[i]);
+
+    return runners;
+}
 
 std::string getDimension(int n1, int n2, int n3, bool sorted = false);
 int digitsCount(size_t n);